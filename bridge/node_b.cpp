@@ -28,10 +28,12 @@ Node::Node(QObject *parent) : QObject(parent) {
 
     node::MwcNode * node = getNode();
 
-    QObject::connect(node, &node::MwcNode::onMwcOutputLine,
-                     this, &Node::onMwcOutputLine, Qt::QueuedConnection);
+    QObject::connect(node, &node::MwcNode::onMwcOutputLines,
+                     this, &Node::onMwcOutputLines, Qt::QueuedConnection);
     QObject::connect(node, &node::MwcNode::onMwcStatusUpdate,
                      this, &Node::onMwcStatusUpdate, Qt::QueuedConnection);
+    QObject::connect(node, &node::MwcNode::onMwcSyncProgress,
+                     this, &Node::onMwcSyncProgress, Qt::QueuedConnection);
 }
 
 Node::~Node() {}
@@ -45,14 +47,18 @@ QStringList Node::getOutputLines() {
     return getNode()->getOutputLines();
 }
 
-void Node::onMwcOutputLine(QString line) {
-    emit sgnMwcOutputLine(line);
+void Node::onMwcOutputLines(QStringList lines) {
+    emit sgnMwcOutputLines(lines);
 }
 
 void Node::onMwcStatusUpdate(QString status) {
     emit sgnMwcStatusUpdate(status);
 }
 
+void Node::onMwcSyncProgress(double progressPercent, qint64 etaSec) {
+    emit sgnMwcSyncProgress(progressPercent, etaSec >= 0 ? node::MwcNodeSyncProgress::etaToString(etaSec) : "");
+}
+
 
 
 }
\ No newline at end of file
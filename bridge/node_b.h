@@ -29,20 +29,24 @@ public:
     // Node log location
     Q_INVOKABLE QString getLogsLocation();
 
-    // Last log lines from the node.
+    // Last log lines from the node, newest first.
     Q_INVOKABLE QStringList getOutputLines();
 
 signals:
-    // New line at Node logs
-    void sgnMwcOutputLine(QString line);
+    // New lines at Node logs, older first. Lines are coming in batches
+    void sgnMwcOutputLines(QStringList lines);
 
     // Node status was changed
     void sgnMwcStatusUpdate(QString status);
 
+    // Sync progress, progressPercent<0 if node is not syncing. eta is like "12 min", empty if unknown yet
+    void sgnMwcSyncProgress(double progressPercent, QString eta);
+
 
 private slots:
-    void onMwcOutputLine(QString line);
+    void onMwcOutputLines(QStringList lines);
     void onMwcStatusUpdate(QString status);
+    void onMwcSyncProgress(double progressPercent, qint64 etaSec);
 
 };
 
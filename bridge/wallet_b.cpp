@@ -16,6 +16,7 @@
 #include "../core/Notification.h"
 #include "../state/state.h"
 #include "../wallet/wallet.h"
+#include "../wallet/mwc713metrics.h"
 
 
 namespace bridge {
@@ -399,4 +400,15 @@ void Wallet::renameAccount(QString oldName, QString newName) {
     getWallet()->renameAccount(oldName, newName);
 }
 
+// mwc713 tasks latency and queue depth metrics, human readable
+QString Wallet::getTaskMetricsReport() {
+    return wallet::getTaskMetrics().getReport();
+}
+
+// Save mwc713 tasks metrics into the json file
+// Return: empty string on success, otherwise error message
+QString Wallet::dumpTaskMetrics(QString fileName) {
+    return wallet::getTaskMetrics().dump(fileName);
+}
+
 }
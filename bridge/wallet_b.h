@@ -139,6 +139,12 @@ public:
     // Check Signal: sgnAccountRenamed(bool success, QString errorMessage);
     Q_INVOKABLE void renameAccount(QString oldName, QString newName);
 
+    // mwc713 tasks latency and queue depth metrics, human readable
+    Q_INVOKABLE QString getTaskMetricsReport();
+    // Save mwc713 tasks metrics into the json file
+    // Return: empty string on success, otherwise error message
+    Q_INVOKABLE QString dumpTaskMetrics(QString fileName);
+
 signals:
     // Updates from the wallet and notification system
     void sgnNewNotificationMessage(int level, QString message); // level: notify::MESSAGE_LEVEL values
@@ -14,9 +14,13 @@
 
 #include "e_transactions_b.h"
 #include "../BridgeManager.h"
+#include "../../state/state.h"
+#include "../../state/e_transactions.h"
 
 namespace bridge {
 
+static state::Transactions * getState() {return (state::Transactions *) state::getState(state::STATE::TRANSACTIONS);}
+
 Transactions::Transactions(QObject *parent) :
     QObject(parent) {
     getBridgeManager()->addTransactions(this);
@@ -26,4 +30,32 @@ Transactions::~Transactions() {
     getBridgeManager()->removeTransactions(this);
 }
 
+QVector<QString> Transactions::searchTransactions(QString query) {
+    return getState()->searchTransactions(query);
+}
+
+QVector<QString> Transactions::getNotIndexedAccounts() {
+    return getState()->getNotIndexedAccounts();
+}
+
+QString Transactions::exportTransactions(QString fileName, bool jsonLines, QString account) {
+    return getState()->exportTransactions(fileName, jsonLines, account);
+}
+
+void Transactions::cancelExport() {
+    getState()->cancelExport();
+}
+
+bool Transactions::isExportRunning() {
+    return getState()->isExportRunning();
+}
+
+void Transactions::exportProgress( int accountsDone, int accountsNum, qint64 records ) {
+    emit sgnExportProgress(accountsDone, accountsNum, QString::number(records));
+}
+
+void Transactions::exportFinished( bool success, bool cancelled, QString fileName, QString message, qint64 records ) {
+    emit sgnExportFinished(success, cancelled, fileName, message, QString::number(records));
+}
+
 }
\ No newline at end of file
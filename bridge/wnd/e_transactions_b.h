@@ -25,6 +25,30 @@ Q_OBJECT
 public:
     explicit Transactions(QObject * parent = nullptr);
     ~Transactions();
+
+    // Search transactions in all accounts. Query is a text for txid, kernel or address, plus optional
+    // 'amount:<mwc>..<mwc>', 'height:<h>..<h>', 'time:<yyyy-MM-dd>..<yyyy-MM-dd>' ranges.
+    // Return: [error message, account, transaction json, account, transaction json, ...]
+    Q_INVOKABLE QVector<QString> searchTransactions(QString query);
+    // Accounts that search doesn't cover yet, they are indexing at the background
+    Q_INVOKABLE QVector<QString> getNotIndexedAccounts();
+
+    // Export transactions into the file at the background. account - account to export, empty for all accounts.
+    // jsonLines - JSON record per line, otherwise CSV
+    // Return: error message, empty string if export is started
+    // Respond: sgnExportProgress, sgnExportFinished
+    Q_INVOKABLE QString exportTransactions(QString fileName, bool jsonLines, QString account);
+    Q_INVOKABLE void cancelExport();
+    Q_INVOKABLE bool isExportRunning();
+
+    // Called by state
+    void exportProgress( int accountsDone, int accountsNum, qint64 records );
+    void exportFinished( bool success, bool cancelled, QString fileName, QString message, qint64 records );
+
+signals:
+    void sgnExportProgress( int accountsDone, int accountsNum, QString records );
+    // cancelled - export was stopped by user or wallet restart, message is the reason. Empty if user cancelled it
+    void sgnExportFinished( bool success, bool cancelled, QString fileName, QString message, QString records );
 };
 
 }
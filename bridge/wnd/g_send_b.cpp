@@ -65,5 +65,9 @@ QString Send::getSpendAllAmount( QString account) {
     return getState()->getSpendAllAmount(account);
 }
 
+QString Send::getTxnFeeEstimateLabel( QString account, QString sendAmount) {
+    return getState()->getTxnFeeEstimateLabel(account, sendAmount);
+}
+
 
 }
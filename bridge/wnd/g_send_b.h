@@ -52,6 +52,10 @@ public:
     // Returns "All" if the amount cannot be calculated
     Q_INVOKABLE QString getSpendAllAmount( QString account);
 
+    // Return fee label text with expected transaction fee for sendAmount (as user input it)
+    // Returns empty string if the fee cannot be estimated
+    Q_INVOKABLE QString getTxnFeeEstimateLabel( QString account, QString sendAmount);
+
 signals:
     void sgnShowSendResult( bool success, QString message );
 };
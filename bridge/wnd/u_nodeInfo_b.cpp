@@ -52,6 +52,11 @@ QString NodeInfo::getMwcNodeStatus() {
     return getState()->getMwcNodeStatus();
 }
 
+// mwc Node sync phases report
+QString NodeInfo::getMwcNodeSyncHistory() {
+    return getState()->getMwcNodeSyncHistory();
+}
+
 // Request wallet full resync
 void NodeInfo::requestWalletResync() {
     getState()->requestWalletResync();
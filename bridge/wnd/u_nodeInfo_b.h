@@ -36,6 +36,9 @@ public:
     // mwc Node status string
     Q_INVOKABLE QString getMwcNodeStatus();
 
+    // mwc Node sync phases report, multiline string. Empty if node wasn't syncing
+    Q_INVOKABLE QString getMwcNodeSyncHistory();
+
     // Request wallet full resync
     Q_INVOKABLE void requestWalletResync();
 
@@ -0,0 +1,108 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tablewithcolumns.h"
+#include <QHeaderView>
+#include <QStyledItemDelegate>
+#include <QAbstractProxyModel>
+#include <QPainter>
+
+// Same as ListWithColumns
+const int ROW_HEIGHT = 30;
+
+// Stripes are painted by view row, so they stay correct for sorted and filtered data.
+// Model BackgroundRole has a priority.
+class TableStripeDelegate : public QStyledItemDelegate {
+public:
+    TableStripeDelegate(QObject * parent) : QStyledItemDelegate(parent) {}
+
+    QColor stripeColor = QColor(255,255,255,0);
+
+    virtual void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override {
+        if ( index.row() % 2 == 1 && !index.data(Qt::BackgroundRole).isValid() )
+            painter->fillRect(option.rect, stripeColor);
+        QStyledItemDelegate::paint(painter, option, index);
+    }
+};
+
+TableWithColumns::TableWithColumns(QWidget *parent) :
+    QTableView(parent)
+{
+    stripeDelegate = new TableStripeDelegate(this);
+    setItemDelegate(stripeDelegate);
+    setListLook();
+}
+
+TableWithColumns::~TableWithColumns() {}
+
+void TableWithColumns::setListLook() {
+    setShowGrid(false);
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+    setSelectionMode(QAbstractItemView::SingleSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setWordWrap(false);
+
+    verticalHeader()->setVisible(false);
+    // Fixed rows height, view doesn't need to ask model about every row size
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(ROW_HEIGHT);
+
+    horizontalHeader()->setFixedHeight( ROW_HEIGHT );
+}
+
+void TableWithColumns::setStripeAlfaDelta( int alpha ) {
+    stripeDelegate->stripeColor.setAlpha(alpha);
+    viewport()->update();
+}
+
+void TableWithColumns::setColumnWidths(QVector<int> widths) {
+    Q_ASSERT( horizontalHeader()->count() == widths.size() );
+
+    for (int u=0;u<widths.size();u++)
+        setColumnWidth(u,widths[u]);
+}
+
+QVector<int> TableWithColumns::getColumnWidths() const {
+    QVector<int> widths(horizontalHeader()->count());
+
+    for (int t=0;t<widths.size();t++)
+        widths[t] = columnWidth(t);
+
+    return widths;
+}
+
+int TableWithColumns::getSelectedRow() const {
+    if (selectionModel() == nullptr)
+        return -1;
+
+    QModelIndexList selRows = selectionModel()->selectedRows();
+    if (selRows.isEmpty())
+        return -1;
+
+    return mapToSourceRow(selRows.front());
+}
+
+int TableWithColumns::mapToSourceRow(const QModelIndex & index) const {
+    QModelIndex idx = index;
+    while ( const QAbstractProxyModel * proxy = qobject_cast<const QAbstractProxyModel *>(idx.model()) )
+        idx = proxy->mapToSource(idx);
+
+    return idx.isValid() ? idx.row() : -1;
+}
+
+void TableWithColumns::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected) {
+    QTableView::selectionChanged(selected, deselected);
+    emit sgnSelectionChanged();
+}
+
@@ -0,0 +1,58 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TABLEWITHCOLUMNS_H
+#define TABLEWITHCOLUMNS_H
+
+#include <QTableView>
+
+class TableStripeDelegate;
+
+// Model based version of ListWithColumns. Data is provided by the model on demand for visible
+// rows only, so the view can handle very large lists. Model can be wrapped into sort/filter proxies,
+// use mapToSourceRow to get the row at the source model.
+class TableWithColumns : public QTableView
+{
+    Q_OBJECT
+
+public:
+    TableWithColumns(QWidget *parent = nullptr);
+    virtual ~TableWithColumns() override;
+
+    // Alpha delta for row stripe coloring. Range 0-255
+    void setStripeAlfaDelta( int alpha );
+
+    // Model must be set before
+    void setColumnWidths(QVector<int> widths);
+    QVector<int> getColumnWidths() const;
+
+    // Get current selected row at the source model. -1 if nothing is selected
+    int getSelectedRow() const;
+
+    // Row at the source model for the view index. -1 if index is invalid
+    int mapToSourceRow(const QModelIndex & index) const;
+
+signals:
+    void sgnSelectionChanged();
+
+protected:
+    virtual void selectionChanged(const QItemSelection &selected, const QItemSelection &deselected) override;
+
+    void setListLook();
+
+protected:
+    TableStripeDelegate * stripeDelegate = nullptr;
+};
+
+#endif // TABLEWITHCOLUMNS_H
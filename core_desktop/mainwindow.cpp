@@ -26,6 +26,7 @@
 #include "../bridge/wallet_b.h"
 #include "../bridge/statemachine_b.h"
 #include "../bridge/util_b.h"
+#include "../bridge/node_b.h"
 #include <QPushButton>
 #include <QApplication>
 #include <QDesktopWidget>
@@ -50,6 +51,7 @@ MainWindow::MainWindow(QWidget *parent) :
     wallet = new bridge::Wallet(this);
     stateMachine = new bridge::StateMachine(this);
     util = new bridge::Util(this);
+    node = new bridge::Node(this);
 
     QObject::connect( coreWindow, &CoreWindow::sgnUpdateActionStates,
                       this, &MainWindow::onSgnUpdateActionStates, Qt::QueuedConnection);
@@ -72,6 +74,9 @@ MainWindow::MainWindow(QWidget *parent) :
     QObject::connect(wallet, &Wallet::sgnUpdateSyncProgress,
                      this, &MainWindow::onSgnUpdateSyncProgress, Qt::QueuedConnection);
 
+    QObject::connect(node, &bridge::Node::sgnMwcSyncProgress,
+                     this, &MainWindow::onSgnMwcSyncProgress, Qt::QueuedConnection);
+
     updateListenerBtn();
     updateNetworkName();
     updateMenu();
@@ -297,6 +302,18 @@ void MainWindow::onSgnUpdateSyncProgress(double progressPercent) {
                              "Wallet state update, " + util::trimStrAsDouble( QString::number(progressPercent), 4 ) + "% complete"  );
 }
 
+void MainWindow::onSgnMwcSyncProgress(double progressPercent, QString eta) {
+    if (progressPercent < 0.0) {
+        nodeSyncStatus = "";
+    }
+    else {
+        nodeSyncStatus = "syncing " + QString::number(progressPercent, 'f', 1) + "%";
+        if (!eta.isEmpty())
+            nodeSyncStatus += ", " + eta + " left";
+    }
+    updateNetworkName();
+}
+
 void MainWindow::onSgnConfigUpdate() {
     updateNetworkName();
 }
@@ -371,7 +388,10 @@ void MainWindow::updateListenerBtn() {
 
 
 void MainWindow::updateNetworkName() {
-    setStatusButtonState( ui->nodeStatusButton, STATUS::IGNORE, config->getNetwork() );
+    QString text = config->getNetwork();
+    if (!nodeSyncStatus.isEmpty())
+        text += " " + nodeSyncStatus;
+    setStatusButtonState( ui->nodeStatusButton, STATUS::IGNORE, text );
 }
 
 void MainWindow::setStatusButtonState(  QPushButton * btn, STATUS status, QString text ) {
@@ -30,6 +30,7 @@ namespace bridge {
     class Wallet;
     class StateMachine;
     class Util;
+    class Node;
 }
 
 class QPushButton;
@@ -70,6 +71,8 @@ private slots:
 
     void onSgnUpdateSyncProgress(double progressPercent);
 
+    void onSgnMwcSyncProgress(double progressPercent, QString eta);
+
     // Internal UI
     void on_listenerStatusButton_clicked();
     void on_nodeStatusButton_clicked();
@@ -123,6 +126,8 @@ private:
     bridge::Wallet * wallet = nullptr;
     bridge::StateMachine * stateMachine = nullptr;
     bridge::Util * util = nullptr;
+    bridge::Node * node = nullptr;
+    QString nodeSyncStatus; // Embedded node sync progress for the status bar. Empty if not syncing
     bool leftBarShown = true;
     core::StatusWndMgr* statusMgr = nullptr;
 };
@@ -33,11 +33,11 @@ ShowOutputDlg::ShowOutputDlg(QWidget *parent, const wallet::WalletOutput &output
     wallet = new bridge::Wallet(this);
     util = new bridge::Util(this);
 
-    ui->status->setText(output.status);
-    ui->height->setText(output.blockHeight);
-    ui->confirms->setText(output.numOfConfirms);
+    ui->status->setText(output.getStatusStr());
+    ui->height->setText(output.getBlockHeightStr());
+    ui->confirms->setText(output.getNumOfConfirmsStr());
     ui->mwc->setText(util::nano2one(output.valueNano));
-    ui->locked->setText(output.lockedUntil);
+    ui->locked->setText(output.getLockedUntilStr());
     ui->coinBase->setText(output.coinbase ? "Yes" : "No");
     ui->tx->setText(QString::number(output.txIdx + 1));
     ui->commitment->setText(output.outputCommitment);
@@ -123,10 +123,10 @@ void ShowTransactionDlg::updateOutputData() {
     ui->out_label4->show();
     ui->out_label5->show();
     ui->out_label6->show();
-    ui->out_status->setText(out.status);
+    ui->out_status->setText(out.getStatusStr());
     ui->out_mwc->setText(util::nano2one( out.valueNano) );
-    ui->out_height->setText( out.blockHeight );
-    ui->out_confirms->setText( out.numOfConfirms );
+    ui->out_height->setText( out.getBlockHeightStr() );
+    ui->out_confirms->setText( out.getNumOfConfirmsStr() );
     ui->out_coinBase->setText(out.coinbase?"Yes":"No");
     ui->out_tx->setText(out.txIdx<0 ? "None" : QString::number(out.txIdx+1) );
 }
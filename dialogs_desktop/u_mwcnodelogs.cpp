@@ -31,8 +31,8 @@ MwcNodeLogs::MwcNodeLogs(QWidget *parent) :
 
     ui->logsEdit->setPlainText( node->getOutputLines().join("\n") );
 
-    QObject::connect(node, &bridge::Node::sgnMwcOutputLine,
-                     this, &MwcNodeLogs::onMwcOutputLine, Qt::QueuedConnection);
+    QObject::connect(node, &bridge::Node::sgnMwcOutputLines,
+                     this, &MwcNodeLogs::onMwcOutputLines, Qt::QueuedConnection);
 }
 
 MwcNodeLogs::~MwcNodeLogs()
@@ -45,8 +45,8 @@ void MwcNodeLogs::on_okButton_clicked()
     accept();
 }
 
-void MwcNodeLogs::onMwcOutputLine(QString line) {
-    Q_UNUSED(line)
+void MwcNodeLogs::onMwcOutputLines(QStringList lines) {
+    Q_UNUSED(lines)
 
     QScrollBar * vSB = ui->logsEdit->verticalScrollBar();
     if (vSB) {
@@ -38,7 +38,7 @@ public:
 
 private slots:
     void on_okButton_clicked();
-    void onMwcOutputLine(QString line);
+    void onMwcOutputLines(QStringList lines);
 
 private:
     Ui::MwcNodeLogs *ui;
@@ -0,0 +1,69 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "dialogs_desktop/x_walletdiagnostics.h"
+#include "ui_x_walletdiagnostics.h"
+#include <QFileDialog>
+#include <QFileInfo>
+#include "../bridge/wallet_b.h"
+#include "../bridge/config_b.h"
+#include "../core/WndManager.h"
+
+namespace dlg {
+
+WalletDiagnostics::WalletDiagnostics(QWidget *parent) :
+    control::MwcDialog(parent),
+    ui(new Ui::WalletDiagnostics)
+{
+    ui->setupUi(this);
+
+    wallet = new bridge::Wallet(this);
+    config = new bridge::Config(this);
+
+    on_refreshButton_clicked();
+}
+
+WalletDiagnostics::~WalletDiagnostics()
+{
+    delete ui;
+}
+
+void WalletDiagnostics::on_okButton_clicked()
+{
+    accept();
+}
+
+void WalletDiagnostics::on_refreshButton_clicked()
+{
+    ui->metricsEdit->setPlainText( wallet->getTaskMetricsReport() );
+}
+
+void WalletDiagnostics::on_saveButton_clicked()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save mwc713 metrics"),
+                                                    config->getPathFor("Diagnostics"),
+                                                    tr("Metrics (*.json)"));
+    if (fileName.length()==0)
+        return;
+
+    if (!fileName.endsWith(".json"))
+        fileName += ".json";
+
+    config->updatePathFor("Diagnostics", QFileInfo(fileName).absolutePath() );
+
+    QString error = wallet->dumpTaskMetrics(fileName);
+    if (!error.isEmpty())
+        core::getWndManager()->messageTextDlg("Error", error);
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef X_WALLETDIAGNOSTICS_H
+#define X_WALLETDIAGNOSTICS_H
+
+#include <QDialog>
+#include "../control_desktop/mwcdialog.h"
+
+namespace Ui {
+class WalletDiagnostics;
+}
+
+namespace bridge {
+class Wallet;
+class Config;
+}
+
+namespace dlg {
+
+// mwc713 tasks metrics: latency, queue wait and parsed output size
+class WalletDiagnostics : public control::MwcDialog
+{
+    Q_OBJECT
+
+public:
+    explicit WalletDiagnostics(QWidget *parent );
+    ~WalletDiagnostics();
+
+private slots:
+    void on_okButton_clicked();
+    void on_refreshButton_clicked();
+    void on_saveButton_clicked();
+
+private:
+    Ui::WalletDiagnostics *ui;
+    bridge::Wallet * wallet = nullptr;
+    bridge::Config * config = nullptr;
+};
+
+}
+
+#endif // X_WALLETDIAGNOSTICS_H
@@ -63,6 +63,9 @@
 #include "tests/testPasswordAnalyser.h"
 #include "tests/testCalcOutputsToSpend.h"
 #include "tests/testLogs.h"
+#include "tests/benchParsers.h"
+#include "tests/benchCoinSelection.h"
+#include "tests/testTrieEngines.h"
 #include "misk/DictionaryInit.h"
 #include "util/stringutils.h"
 #include "build_version.h"
@@ -269,6 +272,17 @@ int main(int argc, char *argv[])
         return app.exec();
     }
 #endif
+#ifdef WALLET_DESKTOP
+    // Parsers benchmark: mwc-qt-wallet --bench_parsers <transcript> [<baseline>]
+    if (argc >= 3 && strcmp(argv[1], "--bench_parsers") == 0) {
+        return test::benchParsers( QString(argv[2]), argc >= 4 ? QString(argv[3]) : QString() ) ? 0 : 1;
+    }
+    // Coin selection benchmark: mwc-qt-wallet --bench_coins <outputs number>
+    if (argc >= 3 && strcmp(argv[1], "--bench_coins") == 0) {
+        return test::benchCoinSelection( QString(argv[2]).toInt() ) ? 0 : 1;
+    }
+#endif
+
     int retVal = 0;
 
     double uiScale = 1.0;
@@ -359,6 +373,7 @@ int main(int argc, char *argv[])
     test::testWordSequences();
     test::testWordDictionary();
     test::testPasswordAnalyser();
+    test::testTrieEngines();
 #endif
 
 
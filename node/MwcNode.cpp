@@ -31,6 +31,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include "MwcNodeConfig.h"
+#include "MwcNodeReader.h"
 #include <QTimer>
 #include <QCoreApplication>
 
@@ -75,13 +76,12 @@ void MwcNode::start(const QString & dataPath, const QString & network ) {
     lastUsedNetwork = network;
     nodeSecret = "";
     nodeWorkDir = "";
-    nonEmittedOutput = "";
     lastProcessedEvent = tries::NODE_OUTPUT_EVENT::NONE;
     nodeStatusString = "Waiting";
 
     // Start the binary
     Q_ASSERT(nodeProcess == nullptr);
-    Q_ASSERT(nodeOutputParser == nullptr);
+    Q_ASSERT(outputReader == nullptr);
 
     qDebug() << "Starting mwc-node  " << nodePath;
 
@@ -89,18 +89,26 @@ void MwcNode::start(const QString & dataPath, const QString & network ) {
 
     nodeNoPeersFailCounter = 0;
     nodeOutOfSyncCounter = 0;
+    timerPeriods = 0;
+    lastPollPeriod = 0;
+    pollWeight = 1;
+    lastPollHealthy = false;
     nodeHeight = 0;
     peersMaxHeight = 0;
     txhashsetHeight = 0;
     syncIsDone = false;
     maxBlockHeight = 0;
     initChainHeight = 0;
+    syncProgress.reset( QDateTime::currentMSecsSinceEpoch() );
+    emit onMwcSyncProgress( -1.0, -1 );
 
     // Creating process and starting
     nodeProcess = initNodeProcess(dataPath, network);
-    nodeOutputParser = new tries::NodeOutputParser();
-
+    tries::NodeOutputParser * nodeOutputParser = new tries::NodeOutputParser();
     connect( nodeOutputParser, &tries::NodeOutputParser::nodeOutputGenericEvent, this, &MwcNode::nodeOutputGenericEvent, Qt::QueuedConnection);
+
+    outputReader = new MwcNodeOutputReader(nodeOutputParser);
+    connect( outputReader->getWorker(), &MwcNodeOutputWorker::sgnOutputLines, this, &MwcNode::onNodeOutputLines, Qt::QueuedConnection);
 }
 
 void MwcNode::stop() {
@@ -159,9 +167,15 @@ void MwcNode::stop() {
         nodeProcess = nullptr;
     }
 
-    if ( nodeOutputParser) {
-        nodeOutputParser->deleteLater();
-        nodeOutputParser = nullptr;
+    if (outputReader) {
+        delete outputReader;
+        outputReader = nullptr;
+    }
+
+    // Unfinished sync phase goes to the history
+    if (syncProgress.isSyncing()) {
+        syncProgress.reset( QDateTime::currentMSecsSinceEpoch() );
+        emit onMwcSyncProgress( -1.0, -1 );
     }
 
     QCoreApplication::processEvents();
@@ -376,103 +390,28 @@ void MwcNode::mwcNodeReadyReadStandardError() {
 }
 
 void MwcNode::mwcNodeReadyReadStandardOutput() {
-    if (nodeProcess) {
-        QString str( ioutils::FilterEscSymbols( nodeProcess->readAllStandardOutput() ) );
-        qDebug() << "Get output:" << str;
-        logger::logMwcNodeOut(str);
-        nodeOutputParser->processInput(str);
-
-        nonEmittedOutput += str;
-
-        QString ln;
-
-        for (int t=0; t<nonEmittedOutput.length(); t++) {
-            QChar ch = nonEmittedOutput[t];
-            if ( ch=='\r' || ch=='\n' ) {
-                if (!ln.isEmpty()) {
-                    emit onMwcOutputLine(ln);
-                    outputLines.push_front(ln);
-                    while( outputLines.size() > 10000 ) // List should be OK with that. It is optimized for head/tail ops.
-                        outputLines.pop_back();
-
-                    ln = "";
-                }
-            }
-            else {
-                ln += ch;
-            }
-        }
-
-        nonEmittedOutput = ln;
+    if (nodeProcess && outputReader) {
+        // Filtering, parsing and logging are done by the reader thread
+        outputReader->pushOutput( nodeProcess->readAllStandardOutput() );
     }
 }
 
-enum class SYNC_STATE {GETTING_HEADERS, TXHASHSET_REQUEST, TXHASHSET_GET, VERIFY_RANGEPROOFS_FOR_TXHASHSET, VERIFY_KERNEL_SIGNATURES, GETTING_BLOCKS };
-// return progress in the range [0-1.0]
-static QString calcProgressStr( int initChainHeight , int txhashsetHeight, int peersMaxHeight, SYNC_STATE syncState, int value ) {
-    // timing:
-    // Headers: 11:00
-    // range proofs download & anpack: 0:34
-    // Verify ranges: 3:23
-    // Getting Blocks: 2:50
-    // Total time: 18:00
-
-    const double getHeadersShare = 0.6;
-    // Calculating shares for operations. Note, txHash stage is optional.
-    double getTxHashShare, verifyRangeProofsShare, verifyKernelSignaturesShare;
-    if (txhashsetHeight>0) {
-        getTxHashShare = 0.05;
-        double hashSetW = (txhashsetHeight - initChainHeight);
-        double blocksSet = (peersMaxHeight - txhashsetHeight) * 100.0;
-        double txShare = hashSetW / ( hashSetW + blocksSet );
-        double totalShare = (1.0 - getHeadersShare-getTxHashShare);
-        verifyRangeProofsShare = 0.6 * totalShare * txShare;
-        verifyKernelSignaturesShare = 0.4 * totalShare * txShare;
-    }
-    else {
-        getTxHashShare = 0.0;
-        verifyRangeProofsShare = 0.0;
-        verifyKernelSignaturesShare = 0.0;
+void MwcNode::onNodeOutputLines(QStringList lines) {
+    if (NODE_OUTPUT_TAIL_LINES > 0) {
+        for (const QString & ln : lines)
+            outputLines.push_front(ln);
+        while( outputLines.size() > NODE_OUTPUT_TAIL_LINES ) // List should be OK with that. It is optimized for head/tail ops.
+            outputLines.pop_back();
     }
 
-    const double gettingBlocksShare = 1.0 - (getHeadersShare + getTxHashShare + verifyRangeProofsShare + verifyKernelSignaturesShare);
-    Q_ASSERT( gettingBlocksShare >= 0.0 );
-
-    double progressRes = 0.0;
-
-    switch( syncState ) {
-        case SYNC_STATE::GETTING_HEADERS: {
-            //
-            progressRes = double(std::max(0, value - initChainHeight)) / double(std::max(1, peersMaxHeight - initChainHeight)) * getHeadersShare  + 0.0;
-            break;
-        }
-        case SYNC_STATE::TXHASHSET_REQUEST:
-            progressRes = getHeadersShare;
-            break;
-        case SYNC_STATE::TXHASHSET_GET:
-            progressRes = getHeadersShare + getTxHashShare;
-            break;
-        case SYNC_STATE::VERIFY_RANGEPROOFS_FOR_TXHASHSET:
-            progressRes = getHeadersShare + getTxHashShare +
-                          double( std::max(0, value-initChainHeight) ) / double( std::max(1, txhashsetHeight-initChainHeight) ) * verifyRangeProofsShare;
-            break;
-        case SYNC_STATE::VERIFY_KERNEL_SIGNATURES:
-            progressRes = getHeadersShare + getTxHashShare + verifyRangeProofsShare +
-                          double( std::max(0, value-initChainHeight) ) / double( std::max(1, txhashsetHeight-initChainHeight) ) * verifyKernelSignaturesShare;
-            break;
-        case SYNC_STATE::GETTING_BLOCKS:
-            progressRes = getHeadersShare + getTxHashShare + verifyRangeProofsShare + verifyKernelSignaturesShare +
-                    double( std::max(0, value - std::max(initChainHeight, txhashsetHeight) )) / double( std::max(1, peersMaxHeight - std::max(initChainHeight, txhashsetHeight)) ) * gettingBlocksShare;
-            break;
-    }
-
-    if (progressRes<0.0)
-        progressRes = 0.0;
-    if (progressRes>1.0)
-        progressRes = 1.0;
-
+    emit onMwcOutputLines(lines);
+}
 
-    return "Syncing " + QString::number( progressRes * 100.0, 'f', 1 ) + "%";
+void MwcNode::updateSyncProgress( SYNC_STATE syncState, int value ) {
+    syncProgress.update( syncState, value, initChainHeight, txhashsetHeight, peersMaxHeight, QDateTime::currentMSecsSinceEpoch() );
+    nodeStatusString = syncProgress.getStatusString();
+    emit onMwcStatusUpdate(nodeStatusString);
+    emit onMwcSyncProgress( syncProgress.getProgress() * 100.0, syncProgress.getEtaSec() );
 }
 
 void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString message) {
@@ -531,11 +470,13 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
                     }
                 }
 
-                nodeStatusString = "Getting headers";
-                if (height > 0 && peersMaxHeight > 0)
-                    nodeStatusString = calcProgressStr( initChainHeight , txhashsetHeight, peersMaxHeight, SYNC_STATE::GETTING_HEADERS, height );
-
-                emit onMwcStatusUpdate(nodeStatusString);
+                if (height > 0 && peersMaxHeight > 0) {
+                    updateSyncProgress( SYNC_STATE::GETTING_HEADERS, height );
+                }
+                else {
+                    nodeStatusString = "Getting headers";
+                    emit onMwcStatusUpdate(nodeStatusString);
+                }
             }
             break;
         }
@@ -560,8 +501,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
                 }
             }
 
-            nodeStatusString = calcProgressStr( initChainHeight , txhashsetHeight, peersMaxHeight, SYNC_STATE::TXHASHSET_REQUEST, 0 );
-            emit onMwcStatusUpdate(nodeStatusString);
+            updateSyncProgress( SYNC_STATE::TXHASHSET_REQUEST, 0 );
             break;
         }
             // expected no break
@@ -576,8 +516,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
             nodeOutOfSyncCounter = 0;
 
             if (! message.contains("DONE") ) {
-                nodeStatusString = calcProgressStr( initChainHeight , txhashsetHeight, peersMaxHeight, SYNC_STATE::TXHASHSET_GET, 0 );
-                emit onMwcStatusUpdate(nodeStatusString);
+                updateSyncProgress( SYNC_STATE::TXHASHSET_GET, 0 );
             }
             break;
         }
@@ -595,8 +534,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
 
             int handledH = message.trimmed().toInt();
             if (handledH>0 && handledH<txhashsetHeight) {
-                nodeStatusString = calcProgressStr( initChainHeight , txhashsetHeight, peersMaxHeight, SYNC_STATE::VERIFY_RANGEPROOFS_FOR_TXHASHSET, handledH );
-                emit onMwcStatusUpdate(nodeStatusString);
+                updateSyncProgress( SYNC_STATE::VERIFY_RANGEPROOFS_FOR_TXHASHSET, handledH );
             }
             break;
         }
@@ -612,8 +550,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
 
             int handledH = message.trimmed().toInt();
             if (handledH>0 && handledH<txhashsetHeight) {
-                nodeStatusString = calcProgressStr( initChainHeight , txhashsetHeight, peersMaxHeight, SYNC_STATE::VERIFY_KERNEL_SIGNATURES, handledH );
-                emit onMwcStatusUpdate(nodeStatusString);
+                updateSyncProgress( SYNC_STATE::VERIFY_KERNEL_SIGNATURES, handledH );
             }
             break;
         }
@@ -642,8 +579,7 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
                         maxBlockHeight = handledH;
 
                         if (handledH > 0 && handledH >= txhashsetHeight && handledH < peersMaxHeight) {
-                                nodeStatusString = calcProgressStr( initChainHeight , txhashsetHeight, peersMaxHeight, SYNC_STATE::GETTING_BLOCKS, handledH );
-                                emit onMwcStatusUpdate(nodeStatusString);
+                                updateSyncProgress( SYNC_STATE::GETTING_BLOCKS, handledH );
                         }
                     }
                 }
@@ -656,6 +592,8 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
             nodeOutOfSyncCounter = 0;
 
             syncIsDone = true;
+            syncProgress.finish( QDateTime::currentMSecsSinceEpoch() );
+            emit onMwcSyncProgress( -1.0, -1 );
 
             // message: 365444412 @ 117485 [0d4879faafaa]
             int idx1 = message.indexOf(" @ ");
@@ -687,6 +625,8 @@ void MwcNode::nodeOutputGenericEvent( tries::NODE_OUTPUT_EVENT event, QString me
                     maxBlockHeight = handledH;
 
                     updateRunningStatus();
+                    // Synced node got a new block. It is the fastest way to know about it, API polling is slower.
+                    emit onMwcTipHeightChanged(handledH);
                 }
             }
             break;
@@ -743,7 +683,7 @@ void MwcNode::updateRunningStatus() {
 void MwcNode::timerEvent(QTimerEvent *event) {
     Q_UNUSED(event)
 
-    if ( nodeProcess== nullptr || nodeOutputParser== nullptr )
+    if ( nodeProcess== nullptr || outputReader== nullptr )
         return;
 
     bool need2restart = false;
@@ -769,6 +709,14 @@ void MwcNode::timerEvent(QTimerEvent *event) {
         return;
     }
 
+    // Synced node with peers doesn't need frequent checks. During sync or with issues checking every period.
+    timerPeriods++;
+    const int pollPeriods = (syncIsDone && lastPollHealthy) ? NODE_POLL_PERIODS_RUNNING : NODE_POLL_PERIODS_SYNC;
+    if (timerPeriods - lastPollPeriod < pollPeriods)
+        return;
+    pollWeight = timerPeriods - lastPollPeriod;
+    lastPollPeriod = timerPeriods;
+
     // Let's make API calls to verify the node status
     sendRequest( "Peers", getNodeSecret(), "/v1/peers/connected");
     sendRequest( "Status", getNodeSecret(), "/v1/status");
@@ -778,6 +726,20 @@ void MwcNode::timerEvent(QTimerEvent *event) {
 void MwcNode::sendRequest( const QString & tag, QString secret,
                 const QString & api, REQUEST_TYPE reqType) {
 
+    if (reqType == REQUEST_TYPE::GET) {
+        // Slow node will get the same request again and again. Waiting for the respond instead.
+        QNetworkReply * pending = pendingReplies.value(tag, nullptr);
+        if (pending != nullptr) {
+            if ( QDateTime::currentMSecsSinceEpoch() - pending->property("sentTime").toLongLong() < NODE_API_REQUEST_TIMEOUT ) {
+                qDebug() << "Skipping request, previous one is still in progress. tag:" << tag;
+                return;
+            }
+            // Respond with error will be processed as a failure
+            pendingReplies.remove(tag);
+            pending->abort();
+        }
+    }
+
     QString url = "http://localhost:13413" + api;
 
     qDebug() << "Sending request: " << url << "  tag:" << tag;
@@ -801,6 +763,7 @@ void MwcNode::sendRequest( const QString & tag, QString secret,
     QByteArray data = concatenated.toLocal8Bit().toBase64();
     QString headerData = "Basic " + data;
     request.setRawHeader("Authorization", headerData.toLocal8Bit());
+    request.setRawHeader("Connection", "keep-alive");
 
     QNetworkReply *reply = nullptr;
     if (reqType == REQUEST_TYPE::GET) {
@@ -814,6 +777,9 @@ void MwcNode::sendRequest( const QString & tag, QString secret,
 
     if (reply) {
         reply->setProperty("tag", QVariant(tag));
+        reply->setProperty("sentTime", QVariant(QDateTime::currentMSecsSinceEpoch()));
+        if (reqType == REQUEST_TYPE::GET)
+            pendingReplies.insert(tag, reply);
         // Respond will be send back async
     }
 }
@@ -823,11 +789,14 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
     QNetworkReply::NetworkError errCode = reply->error();
     QString tag = reply->property("tag").toString();
     QString strReply (reply->readAll().trimmed());
+    if (pendingReplies.value(tag, nullptr) == reply)
+        pendingReplies.remove(tag);
     reply->deleteLater();
     reply = nullptr;
 
     if (errCode != QNetworkReply::NoError) {
-        nodeNoPeersFailCounter++;
+        nodeNoPeersFailCounter += pollWeight;
+        lastPollHealthy = false;
         return;
     }
 
@@ -835,7 +804,8 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
     QJsonDocument   jsonDoc = QJsonDocument::fromJson(strReply.toUtf8(), &error);
 
     if (error.error != QJsonParseError::NoError) {
-        nodeNoPeersFailCounter++;
+        nodeNoPeersFailCounter += pollWeight;
+        lastPollHealthy = false;
         return;
     }
 
@@ -856,7 +826,7 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
             }
 
             if (peersMaxHeight > nodeHeight - 3) {
-                nodeOutOfSyncCounter++;
+                nodeOutOfSyncCounter += pollWeight;
             }
 
             if (syncIsDone)
@@ -886,13 +856,18 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
 
         QJsonObject   jsonRespond = jsonDoc.object();
 
+        const int prevHeight = nodeHeight;
         int connections =   jsonRespond["connections"].toInt(0);
         nodeHeight =        jsonRespond["tip"].toObject()["height"].toInt(0);
         logger::logInfo("MwcNode", "MWC Node status: connections=" + QString::number(connections) +
                 " height="+QString::number(nodeHeight));
 
+        lastPollHealthy = connections > 0;
         if (connections == 0)
-            nodeNoPeersFailCounter++;
+            nodeNoPeersFailCounter += pollWeight;
+
+        if (nodeHeight > 0 && nodeHeight != prevHeight)
+            emit onMwcTipHeightChanged(nodeHeight);
     }
 
 }
@@ -18,7 +18,9 @@
 #include <QObject>
 #include <QProcess>
 #include <QVector>
+#include <QMap>
 #include "../tries/NodeOutputParser.h"
+#include "MwcNodeSyncProgress.h"
 
 class QNetworkAccessManager;
 class QNetworkReply;
@@ -33,6 +35,8 @@ class NodeOutputParser;
 
 namespace node {
 
+class MwcNodeOutputReader;
+
 // Node management timeouts.
 const int64_t CHECK_NODE_PERIOD = 5 * 1000; // Timer check period. API calls to node will be issued
 const int64_t NODE_OUT_OF_SYNC_FAILURE_LIMIT = 60; // Node ouf of sync and nothing was updated...
@@ -45,6 +49,14 @@ const int64_t MWC_NODE_SYNC_MESSAGES = 60*1000; // Sync supposed to be agile
 const int64_t RECEIVE_BLOCK_LISTEN = 10*60*1000; // 10 minutes can be delay due non consistancy. API call expected to catch non sync cases
 const int64_t NETWORK_ISSUES = 0; // Let's not consider network issues. API call will restart the node
 
+// Last output lines that are kept in memory for the logs dialog. 0 - don't keep
+const int NODE_OUTPUT_TAIL_LINES = 10000;
+
+// API polling. Synced and healthy node is polled less often. Failure limits are counted in CHECK_NODE_PERIOD units.
+const int NODE_POLL_PERIODS_SYNC = 1;
+const int NODE_POLL_PERIODS_RUNNING = 3;
+const int64_t NODE_API_REQUEST_TIMEOUT = 30*1000; // Hanging API request is aborted after that
+
 struct PeerInfo {
     QString address;
     int     totalHeight;
@@ -77,10 +89,13 @@ public:
 
     QString getMwcStatus() const { return nodeStatusString; }
 
-    // Last Many node output lines. There are many of them.
+    // Last Many node output lines, newest first. There are many of them, see NODE_OUTPUT_TAIL_LINES.
     // Call from the same thread
     const QStringList & getOutputLines() const {return outputLines;}
 
+    // Sync phases statistic, including previous runs. Multiline string
+    QString getSyncHistoryReport() const { return syncProgress.getHistoryReport(); }
+
     QString getLogsLocation() const;
 private:
     QProcess * initNodeProcess( const QString & dataPath, const QString & network );
@@ -96,20 +111,30 @@ private:
     void reportNodeFatalError( QString message );
 
     void updateRunningStatus();
+    // Sync progress from the node output. Updates the status string
+    void updateSyncProgress( SYNC_STATE syncState, int value );
 
     bool isFinalRun() {return restartCounter>2;}
 private:
     virtual void timerEvent(QTimerEvent *event) override;
 
 private: signals:
-    void onMwcOutputLine(QString line);
+    // New output lines batch, older first
+    void onMwcOutputLines(QStringList lines);
     void onMwcStatusUpdate(QString status);
+    // Node tip is changed. Emitted when the synced node receives a new block (from the node output)
+    // and when API polling finds a new height.
+    void onMwcTipHeightChanged(int height);
+    // Sync progress in percents with estimated seconds to finish (-1 if unknown).
+    // progressPercent<0 - node is not syncing.
+    void onMwcSyncProgress(double progressPercent, qint64 etaSec);
 
 private slots:
     void nodeErrorOccurred(QProcess::ProcessError error);
     void nodeProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void mwcNodeReadyReadStandardError();
     void mwcNodeReadyReadStandardOutput();
+    void onNodeOutputLines(QStringList lines);
 
     void replyFinished(QNetworkReply* reply);
 
@@ -122,7 +147,7 @@ private:
 
     QString nodePath; // path to the backed binary
     QProcess *nodeProcess = nullptr;
-    tries::NodeOutputParser *nodeOutputParser = nullptr; // logs will come from stdout
+    MwcNodeOutputReader *outputReader = nullptr; // stdout processing at the background: parsing and logs
 
     QString lastUsedNetwork;
     PeerConnectionInfo peers; // connected peers. Polling with API
@@ -140,16 +165,21 @@ private:
     int peersMaxHeight = 0;
     int initChainHeight = 0;
 
-    QNetworkAccessManager *nwManager;
+    QNetworkAccessManager *nwManager; // Reused for all requests, so the connection to the node is kept alive
+    QMap<QString, QNetworkReply*> pendingReplies; // API requests in progress by tag. Polls are not duplicated
 
-    tries::NODE_OUTPUT_EVENT lastProcessedEvent = tries::NODE_OUTPUT_EVENT::NONE;
+    int  timerPeriods = 0;   // CHECK_NODE_PERIOD ticks since start
+    int  lastPollPeriod = 0; // Tick of the last API poll
+    int  pollWeight = 1;     // Periods that the last poll covers. Failures are counted with this weight
+    bool lastPollHealthy = false;
 
-    QString nonEmittedOutput;
+    tries::NODE_OUTPUT_EVENT lastProcessedEvent = tries::NODE_OUTPUT_EVENT::NONE;
 
     QString nodeStatusString= "Waiting";
     int     txhashsetHeight = 0;
     int     maxBlockHeight = 0; // backing stopper for getted blocks.
     bool    syncIsDone = false;
+    MwcNodeSyncProgress syncProgress; // Sync phases rates, progress and ETA
 
     // Last Many node output lines
     QStringList outputLines;
@@ -0,0 +1,118 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MwcNodeReader.h"
+#include "../tries/NodeOutputParser.h"
+#include "../util/ioutils.h"
+#include "../util/Log.h"
+#include <QTextCodec>
+
+namespace node {
+
+MwcNodeOutputWorker::MwcNodeOutputWorker(tries::NodeOutputParser * _nodeOutputParser) :
+    nodeOutputParser(_nodeOutputParser),
+    decoder( QTextCodec::codecForName("UTF-8") )
+{}
+
+MwcNodeOutputWorker::~MwcNodeOutputWorker() {
+    delete nodeOutputParser;
+    nodeOutputParser = nullptr;
+}
+
+void MwcNodeOutputWorker::pushOutput(const QByteArray & data) {
+    if (data.isEmpty())
+        return;
+
+    {
+        QMutexLocker l(&pendingLock);
+        pending.append(data);
+    }
+
+    // Waking up the consumer only if it is not scheduled yet. The rest of the data will join the batch.
+    if (wakeScheduled.testAndSetOrdered(0, 1))
+        QMetaObject::invokeMethod(this, "processPending", Qt::QueuedConnection);
+}
+
+void MwcNodeOutputWorker::processPending() {
+    // Reset first, everything that pushed after will schedule a new call
+    wakeScheduled.storeRelease(0);
+
+    QByteArray data;
+    {
+        QMutexLocker l(&pendingLock);
+        data.swap(pending);
+    }
+    if (data.isEmpty())
+        return;
+
+    // Batch can end in the middle of multi byte symbol, decoder holds it for the next batch
+    QString str( decoder.toUnicode( ioutils::FilterEscSymbols(data) ) );
+    nodeOutputParser->processInput(str);
+
+    QStringList lines;
+    int lineStart = 0;
+    const int len = str.length();
+    for (int t=0; t<len; t++) {
+        QChar ch = str[t];
+        if ( ch=='\r' || ch=='\n' ) {
+            if (t > lineStart || !partialLine.isEmpty()) {
+                lines.push_back( partialLine + str.mid(lineStart, t-lineStart) );
+                partialLine.clear();
+            }
+            lineStart = t+1;
+        }
+    }
+    partialLine += str.mid(lineStart);
+
+    if (lines.isEmpty())
+        return;
+
+    logger::logMwcNodeOutLines(lines);
+    emit sgnOutputLines(lines);
+}
+
+void MwcNodeOutputWorker::processRemaining() {
+    processPending();
+
+    if (partialLine.isEmpty())
+        return;
+
+    QStringList lines{partialLine};
+    partialLine.clear();
+    logger::logMwcNodeOutLines(lines);
+    emit sgnOutputLines(lines);
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//    MwcNodeOutputReader
+
+MwcNodeOutputReader::MwcNodeOutputReader(tries::NodeOutputParser * nodeOutputParser) {
+    worker = new MwcNodeOutputWorker(nodeOutputParser);
+    nodeOutputParser->moveToThread(&thread);
+    worker->moveToThread(&thread);
+    thread.setObjectName("mwc-node reader");
+    thread.start();
+}
+
+MwcNodeOutputReader::~MwcNodeOutputReader() {
+    thread.quit();
+    thread.wait();
+
+    // Thread is finished, it is safe to use the worker from here. Last output usually has the exit reason.
+    worker->processRemaining();
+    delete worker;
+    worker = nullptr;
+}
+
+}
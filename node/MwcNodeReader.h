@@ -0,0 +1,96 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_MWCNODEREADER_H
+#define MWC_QT_WALLET_MWCNODEREADER_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QStringList>
+#include <QTextDecoder>
+
+namespace tries {
+class NodeOutputParser;
+}
+
+namespace node {
+
+// Worker that runs mwc-node stdout pipeline: filter -> parse -> split -> log.
+// It lives at its own thread. mwc-node prints thousands of lines per second during sync, so
+// GUI thread only hands the raw bytes over. Everything that came since the last run is processed
+// as a single batch: lines are logged with one flush and delivered with one signal.
+class MwcNodeOutputWorker : public QObject {
+    Q_OBJECT
+public:
+    // Take ownership of the parser
+    MwcNodeOutputWorker(tries::NodeOutputParser * nodeOutputParser);
+    virtual ~MwcNodeOutputWorker() override;
+
+    MwcNodeOutputWorker(const MwcNodeOutputWorker & ) = delete;
+    MwcNodeOutputWorker & operator=(const MwcNodeOutputWorker & ) = delete;
+
+    // Producer side, raw mwc-node stdout. Can be called from any thread
+    void pushOutput(const QByteArray & data);
+
+public slots:
+    // Consumer side, worker thread. Process everything that was pushed
+    void processPending();
+
+    // Process the rest of the data, the last line without end of line goes to the logs as well.
+    // Call when the thread is stopped.
+    void processRemaining();
+
+signals:
+    // Complete output lines from the batch, older first
+    void sgnOutputLines(QStringList lines);
+
+private:
+    tries::NodeOutputParser * nodeOutputParser = nullptr; // owned
+
+    QMutex     pendingLock;
+    QByteArray pending; // Data that wasn't processed yet
+    QAtomicInt wakeScheduled; // 1 if processPending is queued and not started yet
+
+    QTextDecoder decoder; // Keeps incomplete UTF-8 sequence from the end of the batch until the rest arrives
+    QString    partialLine; // Last line without end of line, waiting for the rest
+};
+
+// Owner of the worker and its thread. Created for every mwc-node process run.
+class MwcNodeOutputReader {
+public:
+    // Take ownership of the parser, it will be moved to the worker thread.
+    // Note: parser signals must be connected before.
+    MwcNodeOutputReader(tries::NodeOutputParser * nodeOutputParser);
+    // Stop the thread. Data that wasn't processed yet is processed at the caller thread
+    ~MwcNodeOutputReader();
+
+    MwcNodeOutputReader(const MwcNodeOutputReader & ) = delete;
+    MwcNodeOutputReader & operator=(const MwcNodeOutputReader & ) = delete;
+
+    void pushOutput(const QByteArray & data) { worker->pushOutput(data); }
+
+    // For signal connections
+    MwcNodeOutputWorker * getWorker() const {return worker;}
+
+private:
+    QThread thread;
+    MwcNodeOutputWorker * worker = nullptr;
+};
+
+}
+
+#endif //MWC_QT_WALLET_MWCNODEREADER_H
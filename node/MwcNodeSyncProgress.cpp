@@ -0,0 +1,253 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MwcNodeSyncProgress.h"
+#include "../util/Log.h"
+#include <QStringList>
+#include <QtGlobal>
+
+namespace node {
+
+static QString getPhaseName(SYNC_STATE phase) {
+    switch (phase) {
+        case SYNC_STATE::GETTING_HEADERS:                   return "Headers";
+        case SYNC_STATE::TXHASHSET_REQUEST:                 return "Txhashset request";
+        case SYNC_STATE::TXHASHSET_GET:                     return "Txhashset download";
+        case SYNC_STATE::VERIFY_RANGEPROOFS_FOR_TXHASHSET:  return "Range proofs";
+        case SYNC_STATE::VERIFY_KERNEL_SIGNATURES:          return "Kernel signatures";
+        case SYNC_STATE::GETTING_BLOCKS:                    return "Blocks";
+    }
+    return "Unknown";
+}
+
+// Empty for the phases without units
+static QString getPhaseUnits(SYNC_STATE phase) {
+    switch (phase) {
+        case SYNC_STATE::GETTING_HEADERS:                   return "headers";
+        case SYNC_STATE::VERIFY_RANGEPROOFS_FOR_TXHASHSET:  return "rangeproofs";
+        case SYNC_STATE::VERIFY_KERNEL_SIGNATURES:          return "kernels";
+        case SYNC_STATE::GETTING_BLOCKS:                    return "blocks";
+        default:                                            return "";
+    }
+}
+
+// h:mm:ss or m:ss
+static QString durationToString(int64_t durationMs) {
+    int64_t sec = durationMs / 1000;
+    QString res = QString::number(sec % 60).rightJustified(2, '0');
+    int64_t min = sec / 60;
+    if (min >= 60)
+        return QString::number(min / 60) + ":" + QString::number(min % 60).rightJustified(2, '0') + ":" + res;
+    return QString::number(min) + ":" + res;
+}
+
+double SyncPhaseStats::getAvgRate() const {
+    if (duration <= 0 || getPhaseUnits(phase).isEmpty())
+        return 0.0;
+    return double(qMax(0, endValue - startValue)) * 1000.0 / double(duration);
+}
+
+QString SyncPhaseStats::toString() const {
+    QString res = getPhaseName(phase) + ": " + durationToString(duration);
+    QString units = getPhaseUnits(phase);
+    if (!units.isEmpty()) {
+        res += ", heights " + QString::number(startValue) + "-" + QString::number(endValue) +
+               ", " + QString::number(getAvgRate(), 'f', 1) + " " + units + "/s";
+    }
+    if (interrupted)
+        res += ", interrupted";
+    return res;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//    MwcNodeSyncProgress
+
+void MwcNodeSyncProgress::reset(int64_t curTime) {
+    if (syncing)
+        closePhase(curTime, true);
+
+    syncing = false;
+    progress = 0.0;
+    rate = 0.0;
+    secPerProgress = 0.0;
+}
+
+void MwcNodeSyncProgress::update( SYNC_STATE state, int value, int initChainHeight, int txhashsetHeight, int peersMaxHeight, int64_t curTime ) {
+    if (!syncing || current.phase != state) {
+        if (syncing)
+            closePhase(curTime, false);
+        startPhase(state, value, curTime);
+        syncing = true;
+    }
+
+    const double getHeadersShare = 0.6;
+    // Calculating shares for operations. Note, txHash stage is optional.
+    double getTxHashShare, verifyRangeProofsShare, verifyKernelSignaturesShare;
+    if (txhashsetHeight>0) {
+        getTxHashShare = 0.05;
+        double hashSetW = (txhashsetHeight - initChainHeight);
+        double blocksSet = (peersMaxHeight - txhashsetHeight) * 100.0;
+        double txShare = hashSetW / ( hashSetW + blocksSet );
+        double totalShare = (1.0 - getHeadersShare-getTxHashShare);
+        verifyRangeProofsShare = 0.6 * totalShare * txShare;
+        verifyKernelSignaturesShare = 0.4 * totalShare * txShare;
+    }
+    else {
+        getTxHashShare = 0.0;
+        verifyRangeProofsShare = 0.0;
+        verifyKernelSignaturesShare = 0.0;
+    }
+
+    const double gettingBlocksShare = 1.0 - (getHeadersShare + getTxHashShare + verifyRangeProofsShare + verifyKernelSignaturesShare);
+    Q_ASSERT( gettingBlocksShare >= 0.0 );
+
+    // Phases without units don't have own share, they just move the progress forward
+    phaseFrom = phaseTo = 0;
+    phaseShare = 0.0;
+    switch( state ) {
+        case SYNC_STATE::GETTING_HEADERS:
+            phaseBase = 0.0;
+            phaseShare = getHeadersShare;
+            phaseFrom = initChainHeight;
+            phaseTo = peersMaxHeight;
+            break;
+        case SYNC_STATE::TXHASHSET_REQUEST:
+            phaseBase = getHeadersShare;
+            break;
+        case SYNC_STATE::TXHASHSET_GET:
+            phaseBase = getHeadersShare + getTxHashShare;
+            break;
+        case SYNC_STATE::VERIFY_RANGEPROOFS_FOR_TXHASHSET:
+            phaseBase = getHeadersShare + getTxHashShare;
+            phaseShare = verifyRangeProofsShare;
+            phaseFrom = initChainHeight;
+            phaseTo = txhashsetHeight;
+            break;
+        case SYNC_STATE::VERIFY_KERNEL_SIGNATURES:
+            phaseBase = getHeadersShare + getTxHashShare + verifyRangeProofsShare;
+            phaseShare = verifyKernelSignaturesShare;
+            phaseFrom = initChainHeight;
+            phaseTo = txhashsetHeight;
+            break;
+        case SYNC_STATE::GETTING_BLOCKS:
+            phaseBase = getHeadersShare + getTxHashShare + verifyRangeProofsShare + verifyKernelSignaturesShare;
+            phaseShare = gettingBlocksShare;
+            phaseFrom = qMax(initChainHeight, txhashsetHeight);
+            phaseTo = peersMaxHeight;
+            break;
+    }
+
+    // Node output is async, heights can come not in order
+    current.endValue = qMax(current.endValue, value);
+    current.duration = curTime - current.startTime;
+
+    progress = phaseBase + double( qMax(0, current.endValue - phaseFrom) ) / double( qMax(1, phaseTo - phaseFrom) ) * phaseShare;
+    if (progress<0.0)
+        progress = 0.0;
+    if (progress>1.0)
+        progress = 1.0;
+
+    if (phaseShare > 0.0 && curTime - sampleTime >= SYNC_RATE_SAMPLE_MS) {
+        double sample = double(current.endValue - sampleValue) * 1000.0 / double(curTime - sampleTime);
+        rate = rate > 0.0 ? rate + SYNC_RATE_SMOOTHING * (sample - rate) : sample;
+        sampleValue = current.endValue;
+        sampleTime = curTime;
+
+        // Tiny phases are too noisy to predict the rest of the sync
+        if (rate > 0.0 && phaseShare >= 0.05 && phaseTo > phaseFrom)
+            secPerProgress = double(phaseTo - phaseFrom) / rate / phaseShare;
+    }
+}
+
+void MwcNodeSyncProgress::finish(int64_t curTime) {
+    if (syncing)
+        closePhase(curTime, false);
+
+    syncing = false;
+    progress = 1.0;
+    rate = 0.0;
+}
+
+int64_t MwcNodeSyncProgress::getEtaSec() const {
+    if (!syncing || secPerProgress <= 0.0)
+        return -1;
+
+    double eta;
+    if (phaseShare > 0.0 && rate > 0.0) {
+        // Current phase with its own rate, the rest with the measured speed
+        eta = double( qMax(0, phaseTo - current.endValue) ) / rate +
+              qMax(0.0, 1.0 - phaseBase - phaseShare) * secPerProgress;
+    }
+    else {
+        eta = (1.0 - progress) * secPerProgress;
+    }
+
+    return qMax( int64_t(0), int64_t(eta + 0.5) );
+}
+
+QString MwcNodeSyncProgress::getStatusString() const {
+    QString res = "Syncing " + QString::number( progress * 100.0, 'f', 1 ) + "%";
+    int64_t eta = getEtaSec();
+    if (eta >= 0)
+        res += ", about " + etaToString(eta) + " left";
+    return res;
+}
+
+QString MwcNodeSyncProgress::getHistoryReport() const {
+    QStringList lines;
+    for (const SyncPhaseStats & ph : history)
+        lines.push_back(ph.toString());
+
+    if (syncing) {
+        QString line = current.toString() + ", in progress";
+        if (rate > 0.0)
+            line += ", now " + QString::number(rate, 'f', 1) + " " + getPhaseUnits(current.phase) + "/s";
+        lines.push_back(line);
+    }
+    return lines.join("\n");
+}
+
+QString MwcNodeSyncProgress::etaToString(int64_t etaSec) {
+    if (etaSec < 60)
+        return "1 min";
+    int64_t min = (etaSec + 59) / 60;
+    if (min < 60)
+        return QString::number(min) + " min";
+    return QString::number(min / 60) + " h " + QString::number(min % 60).rightJustified(2, '0') + " min";
+}
+
+void MwcNodeSyncProgress::startPhase( SYNC_STATE state, int value, int64_t curTime ) {
+    current = SyncPhaseStats();
+    current.phase = state;
+    current.startTime = curTime;
+    current.startValue = value;
+    current.endValue = value;
+
+    sampleValue = value;
+    sampleTime = curTime;
+    rate = 0.0;
+}
+
+void MwcNodeSyncProgress::closePhase( int64_t curTime, bool interrupted ) {
+    current.duration = curTime - current.startTime;
+    current.interrupted = interrupted;
+
+    logger::logInfo("MWC-NODE", "Sync phase is finished. " + current.toString());
+
+    history.push_back(current);
+    while (history.size() > SYNC_HISTORY_LIMIT)
+        history.pop_front();
+}
+
+}
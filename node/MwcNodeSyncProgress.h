@@ -0,0 +1,115 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_MWCNODESYNCPROGRESS_H
+#define MWC_QT_WALLET_MWCNODESYNCPROGRESS_H
+
+#include <QString>
+#include <QVector>
+
+namespace node {
+
+enum class SYNC_STATE {GETTING_HEADERS, TXHASHSET_REQUEST, TXHASHSET_GET, VERIFY_RANGEPROOFS_FOR_TXHASHSET, VERIFY_KERNEL_SIGNATURES, GETTING_BLOCKS };
+
+// mwc-node reports the progress in bursts, the phase rate is sampled not more often than that
+const int64_t SYNC_RATE_SAMPLE_MS = 2*1000;
+// Weight of the new rate sample, exponential smoothing
+const double SYNC_RATE_SMOOTHING = 0.2;
+// Finished phases that we keep for the report. Include phases from previous node runs
+const int SYNC_HISTORY_LIMIT = 30;
+
+// Statistic for a single sync phase
+struct SyncPhaseStats {
+    SYNC_STATE phase = SYNC_STATE::GETTING_HEADERS;
+    int64_t startTime  = 0; // ms since epoch
+    int64_t duration   = 0; // ms
+    int     startValue = 0; // height at the phase start
+    int     endValue   = 0; // last reported height
+    bool    interrupted = false; // node was stopped before the phase was finished
+
+    // Average rate, units per second. 0 for phases without units (txhashset download)
+    double getAvgRate() const;
+
+    // Single line for the logs and the report
+    QString toString() const;
+};
+
+// Embedded node sync progress model. Tracks every sync phase with a smoothed rate,
+// calculates the total progress and estimation to finish.
+// Phases shares are based on timing for the average hardware:
+//   Headers: 11:00
+//   range proofs download & anpack: 0:34
+//   Verify ranges: 3:23
+//   Getting Blocks: 2:50
+//   Total time: 18:00
+class MwcNodeSyncProgress {
+public:
+    // Sync is started from scratch or aborted. Current phase goes to the history as interrupted.
+    void reset(int64_t curTime);
+
+    // New progress value for the phase. value is the height that the node reached.
+    void update( SYNC_STATE state, int value, int initChainHeight, int txhashsetHeight, int peersMaxHeight, int64_t curTime );
+
+    // Sync is done, the last phase goes to the history
+    void finish(int64_t curTime);
+
+    bool isSyncing() const {return syncing;}
+
+    // Total progress in the range [0-1.0]
+    double getProgress() const {return progress;}
+
+    // Estimated time to finish in seconds. -1 if it is unknown yet
+    int64_t getEtaSec() const;
+
+    // Status for UI, like: "Syncing 45.2%, about 12 min left"
+    QString getStatusString() const;
+
+    // Finished phases, older first
+    const QVector<SyncPhaseStats> & getHistory() const {return history;}
+    // Multiline report for the history and current phase
+    QString getHistoryReport() const;
+
+    // ETA as a short string: "12 min", "1 h 05 min"
+    static QString etaToString(int64_t etaSec);
+
+private:
+    void startPhase( SYNC_STATE state, int value, int64_t curTime );
+    void closePhase( int64_t curTime, bool interrupted );
+
+private:
+    bool syncing = false;
+    SyncPhaseStats current;
+
+    // Phase range and share of the total progress
+    int    phaseFrom = 0;
+    int    phaseTo = 0;
+    double phaseBase = 0.0;  // progress before the phase
+    double phaseShare = 0.0; // phase part of the progress
+
+    // Rate sampling
+    int     sampleValue = 0;
+    int64_t sampleTime = 0;
+    double  rate = 0.0;  // smoothed units per second
+
+    // Seconds per 1.0 of the progress. Measured on the phases with units, used to estimate the phases ahead
+    double  secPerProgress = 0.0;
+
+    double progress = 0.0;
+
+    QVector<SyncPhaseStats> history;
+};
+
+}
+
+#endif //MWC_QT_WALLET_MWCNODESYNCPROGRESS_H
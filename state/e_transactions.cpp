@@ -20,14 +20,35 @@
 #include "../core/WndManager.h"
 #include "../bridge/BridgeManager.h"
 #include "../bridge/wnd/e_transactions_b.h"
+#include "../wallet/transactionsindex.h"
+#include "../util/transactionsexport.h"
+#include <QThread>
 
 namespace state {
 
+// Search is for the human, there is no reasons to show more
+const int SEARCH_RESULTS_LIMIT = 1000;
+
 Transactions::Transactions( StateContext * context) :
     State(context, STATE::TRANSACTIONS)
-{}
+{
+    QObject::connect( context->wallet, &wallet::Wallet::onAllTransactionsChunk,
+                      this, &Transactions::onAllTransactionsChunk, Qt::QueuedConnection );
+    QObject::connect( context->wallet, &wallet::Wallet::onAllTransactionsStreamEnd,
+                      this, &Transactions::onAllTransactionsStreamEnd, Qt::QueuedConnection );
+    QObject::connect( context->wallet, &wallet::Wallet::onLogout,
+                      this, &Transactions::onLogout, Qt::QueuedConnection );
+}
 
-Transactions::~Transactions() {}
+Transactions::~Transactions() {
+    if (exportWriter != nullptr) {
+        // Finishing at the writer thread before it is stopped, so the partial file is removed now
+        exportWriter->cancel();
+        QMetaObject::invokeMethod( exportWriter, "onFinish", Qt::BlockingQueuedConnection,
+                                   Q_ARG(bool, false), Q_ARG(QString, "") );
+    }
+    stopExportThread();
+}
 
 NextStateRespond Transactions::execute() {
     if (context->appContext->getActiveWndState() != STATE::TRANSACTIONS)
@@ -39,4 +60,119 @@ NextStateRespond Transactions::execute() {
     return NextStateRespond( NextStateRespond::RESULT::WAIT_FOR_ACTION );
 };
 
+QVector<QString> Transactions::searchTransactions(QString query) {
+    wallet::TransactionsQuery txQuery;
+    QString error = wallet::TransactionsQuery::parse(query, txQuery);
+    if (!error.isEmpty() || txQuery.isEmpty())
+        return {error};
+
+    QVector<QString> result{""};
+    for (const wallet::IndexedTransaction & tx : context->wallet->searchTransactions(txQuery, SEARCH_RESULTS_LIMIT)) {
+        result.push_back(tx.account);
+        result.push_back(tx.transaction.toJson());
+    }
+    return result;
+}
+
+QVector<QString> Transactions::getNotIndexedAccounts() {
+    return context->wallet->getNotIndexedAccounts();
+}
+
+QString Transactions::exportTransactions(QString fileName, bool jsonLines, QString account) {
+    if (exportWriter != nullptr)
+        return "Previous export is still in progress. Please wait until it is finished or cancel it.";
+
+    logger::logInfo("Transactions", "Starting export into " + fileName + " for " + (account.isEmpty() ? "all accounts" : "account " + account) );
+
+    exportFileName = fileName;
+    exportWriter = new util::TransactionsExportWriter( fileName,
+            jsonLines ? util::EXPORT_FORMAT::JSON_LINES : util::EXPORT_FORMAT::CSV, account.isEmpty() );
+    exportThread = new QThread();
+    exportWriter->moveToThread(exportThread);
+
+    // Writer and thread are deleted when thread is stopped
+    QObject::connect( exportThread, &QThread::finished, exportWriter, &QObject::deleteLater );
+    QObject::connect( exportThread, &QThread::finished, exportThread, &QObject::deleteLater );
+
+    QObject::connect( this, &Transactions::sgnExportChunk,
+                      exportWriter, &util::TransactionsExportWriter::onTransactions, Qt::QueuedConnection );
+    QObject::connect( this, &Transactions::sgnExportEnd,
+                      exportWriter, &util::TransactionsExportWriter::onEnd, Qt::QueuedConnection );
+    QObject::connect( exportWriter, &util::TransactionsExportWriter::sgnProgress,
+                      this, &Transactions::onExportProgress, Qt::QueuedConnection );
+    QObject::connect( exportWriter, &util::TransactionsExportWriter::sgnFinished,
+                      this, &Transactions::onExportFinished, Qt::QueuedConnection );
+
+    exportThread->start();
+    QMetaObject::invokeMethod( exportWriter, "onStart", Qt::QueuedConnection );
+
+    exportStreamId = context->wallet->streamAllTransactions(account);
+    return "";
+}
+
+void Transactions::cancelExport() {
+    if (exportWriter != nullptr)
+        exportWriter->cancel();
+}
+
+void Transactions::onAllTransactionsChunk( int streamId, QString account, int accountIdx, int accountsNum, QVector<wallet::WalletTransaction> transactions ) {
+    // Streams from the finished exports are still served by mwc713
+    if (streamId != exportStreamId || exportStreamId == 0)
+        return;
+
+    // QVector is shared, the data is not copied
+    emit sgnExportChunk(account, accountIdx, accountsNum, transactions);
+}
+
+void Transactions::onAllTransactionsStreamEnd( int streamId, bool completed ) {
+    if (streamId != exportStreamId || exportStreamId == 0)
+        return;
+
+    exportStreamId = 0;
+    if (completed) {
+        emit sgnExportEnd();
+    }
+    else if (exportWriter != nullptr) {
+        // mwc713 was stopped, the rest of the data will never come
+        exportWriter->cancel("Export was interrupted because the wallet was restarted");
+    }
+}
+
+void Transactions::onLogout() {
+    // mwc713 is stopped, no more data will come
+    exportStreamId = 0;
+    if (exportWriter != nullptr)
+        exportWriter->cancel();
+}
+
+void Transactions::onExportProgress( int accountsDone, int accountsNum, qint64 records ) {
+    for (auto b : bridge::getBridgeManager()->getTransactions())
+        b->exportProgress(accountsDone, accountsNum, records);
+}
+
+void Transactions::onExportFinished( bool success, bool cancelled, QString message, qint64 records ) {
+    logger::logInfo("Transactions", "Export into " + exportFileName + " is finished. success=" + QString(success ? "true" : "false") +
+                    " cancelled=" + QString(cancelled ? "true" : "false") + " records=" + QString::number(records) + " " + message );
+
+    // Wallet might continue to stream the data, it will be dropped by the stream id
+    exportStreamId = 0;
+    stopExportThread();
+
+    for (auto b : bridge::getBridgeManager()->getTransactions())
+        b->exportFinished(success, cancelled, exportFileName, message, records);
+}
+
+void Transactions::stopExportThread() {
+    if (exportThread == nullptr)
+        return;
+
+    QObject::disconnect( this, nullptr, exportWriter, nullptr );
+    QObject::disconnect( exportWriter, nullptr, this, nullptr );
+    exportThread->quit();
+    exportThread->wait();
+
+    exportThread = nullptr;
+    exportWriter = nullptr;
+}
+
 }
@@ -19,6 +19,12 @@
 #include "../wallet/wallet.h"
 #include "../core/Notification.h"
 
+class QThread;
+
+namespace util {
+class TransactionsExportWriter;
+}
+
 namespace state {
 
 
@@ -29,12 +35,46 @@ public:
     Transactions( StateContext * context );
     virtual ~Transactions() override;
 
+    // Search transactions in all accounts. Query format see wallet::TransactionsQuery::parse
+    // Return: [error message, account, transaction json, account, transaction json, ...]
+    QVector<QString> searchTransactions(QString query);
+    // Accounts that search doesn't cover yet, they are indexing at the background
+    QVector<QString> getNotIndexedAccounts();
+
+    // Export transactions into the file. Data is streamed from mwc713 and written by the background thread.
+    // account - account to export, empty for all accounts.
+    // Return: error message, empty string if export is started.
+    // Progress and result are reported to bridge::Transactions
+    QString exportTransactions(QString fileName, bool jsonLines, QString account);
+    void cancelExport();
+    bool isExportRunning() const {return exportWriter != nullptr;}
+
 protected:
     virtual NextStateRespond execute() override;
 
     virtual QString getHelpDocName() override {return "transactions.html";}
 
+signals:
+    // Data for the export writer, it is at the different thread
+    void sgnExportChunk( QString account, int accountIdx, int accountsNum, QVector<wallet::WalletTransaction> transactions );
+    void sgnExportEnd();
+
+private slots:
+    void onAllTransactionsChunk( int streamId, QString account, int accountIdx, int accountsNum, QVector<wallet::WalletTransaction> transactions );
+    void onAllTransactionsStreamEnd( int streamId, bool completed );
+    void onLogout();
+
+    void onExportProgress( int accountsDone, int accountsNum, qint64 records );
+    void onExportFinished( bool success, bool cancelled, QString message, qint64 records );
+
+private:
+    void stopExportThread();
+
 private:
+    QThread * exportThread = nullptr;
+    util::TransactionsExportWriter * exportWriter = nullptr; // Lives at exportThread
+    QString   exportFileName;
+    int       exportStreamId = 0; // Wallet stream that feeds the export, 0 if no data is expected. Other streams are dropped.
 };
 
 }
@@ -295,6 +295,22 @@ QString Send::getSpendAllAmount(QString account) {
     return util::getAllSpendableAmount(account, context->wallet, context->appContext);
 }
 
+QString Send::getTxnFeeEstimateLabel(QString account, QString sendAmount) {
+    int64_t amount = -1;
+    if (sendAmount != "All") {
+        QPair<bool, int64_t> mwcAmount = util::one2nano(sendAmount);
+        if (!mwcAmount.first || mwcAmount.second<=0)
+            return "";
+        amount = mwcAmount.second;
+    }
+
+    util::TxnFeeEstimate estimate = util::estimateTxnFee(account, amount, context->wallet,
+                                                         context->appContext->getSendCoinsParams().changeOutputs);
+    if (estimate.fee == 0)
+        return "";
+    return "Transaction fee: " + util::txnFeeToString(estimate.fee) + " MWC";
+}
+
 
 void Send::sendRespond( bool success, QStringList errors, QString address, int64_t txid, QString slate ) {
     Q_UNUSED(address)
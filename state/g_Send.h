@@ -55,6 +55,10 @@ public:
     // Returns the amount of coins, minus the transaction fee, which can be spent for this account
     QString getSpendAllAmount(QString account);
 
+    // Returns the fee label text for the amount as user input it, same for desktop and mobile.
+    // Empty string if fee can't be estimated
+    QString getTxnFeeEstimateLabel(QString account, QString sendAmount);
+
 protected:
     virtual NextStateRespond execute() override;
     virtual QString getHelpDocName() override {return "send.html";}
@@ -98,7 +98,8 @@ void Accounts::timerEvent(QTimerEvent *event) {
             lastNodeIsHealty = true;
         }
         else {
-            context->wallet->updateWalletBalance(true, false);
+            // Idle wallet doesn't need to be refreshed on every tick
+            context->wallet->updateWalletBalanceIfChanged(true);
         }
     }
     else {
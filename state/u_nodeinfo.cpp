@@ -28,6 +28,7 @@
 #include "../bridge/BridgeManager.h"
 #include "../bridge/wnd/u_nodeInfo_b.h"
 #include <QDir>
+#include <QTimer>
 
 namespace state {
 
@@ -61,8 +62,13 @@ NodeInfo::NodeInfo(StateContext * _context) :
     QObject::connect(context->wallet, &wallet::Wallet::onSubmitFile,
                      this, &NodeInfo::onSubmitFile, Qt::QueuedConnection);
 
-    // Checking/update node status every 20 seconds...
-    startTimer(3000); // Let's update node info every 60 seconds. By some reasons it is slow operation...
+    QObject::connect(context->mwcNode, &node::MwcNode::onMwcTipHeightChanged,
+                     this, &NodeInfo::onMwcTipHeightChanged, Qt::QueuedConnection);
+
+    pollTimer = new QTimer(this);
+    pollTimer->setSingleShot(true);
+    QObject::connect(pollTimer, &QTimer::timeout, this, &NodeInfo::onPollTimer);
+    pollTimer->start(NODE_POLL_WAIT_LOGIN_MS);
 }
 
 NodeInfo::~NodeInfo() {
@@ -73,6 +79,10 @@ QString NodeInfo::getMwcNodeStatus() {
     return context->mwcNode->getMwcStatus();
 }
 
+QString NodeInfo::getMwcNodeSyncHistory() {
+    return context->mwcNode->getSyncHistoryReport();
+}
+
 NextStateRespond NodeInfo::execute() {
     if ( context->appContext->getActiveWndState() != STATE::NODE_INFO )
         return NextStateRespond(NextStateRespond::RESULT::DONE);
@@ -101,37 +111,40 @@ void NodeInfo::onLoginResult(bool ok) {
 }
 
 
-void NodeInfo::timerEvent(QTimerEvent *event) {
-    Q_UNUSED(event)
+void NodeInfo::onPollTimer() {
+    // Don't request for init or lock states.
+    if ( context->stateMachine->getCurrentStateId() < STATE::ACCOUNTS ) {
+        pollTimer->start(NODE_POLL_WAIT_LOGIN_MS);
+        return;
+    }
 
-    timerCounter++;
+    requestNodeInfo();
+    pollRequested = true;
+    // If respond will never come, poll again anyway. onNodeStatus will set the real interval.
+    pollTimer->start( qMax(calcPollInterval(false), NODE_POLL_OFFLINE_MS) );
+}
 
-    // Don't request for init or lock states.
-    if ( context->stateMachine->getCurrentStateId() >= STATE::ACCOUNTS ) {
-        int div = 1;
-        if ( currentNodeConnection.connectionType == wallet::MwcNodeConnection::NODE_CONNECTION_TYPE::CLOUD ) {
-            // timer is 3 seconds.
-            div = 20; // want to update once in a minute
-        }
-        else if (!lastNodeStatus.online) {
-            div = 5; // oflline node, doesn't make sense to update too often
-        }
-        else if (lastNodeStatus.connections==0) {
-            div = 5; // no peers, likely an issue,  doesn't make sense to update too often
-        }
-        else if (lastNodeStatus.nodeHeight < lastNodeStatus.peerHeight - 3) {
-            // must be in sync mode...
-            div = 1;
-        }
-        else {
-            // normal running mode, local node
-            div =3;
-        }
+int NodeInfo::calcPollInterval(bool newBlock) const {
+    if ( currentNodeConnection.connectionType == wallet::MwcNodeConnection::NODE_CONNECTION_TYPE::CLOUD )
+        return NODE_POLL_CLOUD_MS;
+    if (!lastNodeStatus.online || lastNodeStatus.connections==0)
+        return NODE_POLL_OFFLINE_MS;
+    if (lastNodeStatus.nodeHeight < lastNodeStatus.peerHeight - 3)
+        return NODE_POLL_SYNC_MS; // must be in sync mode...
+    // Embedded node reports the new blocks from its output as they come (onMwcTipHeightChanged), polling is a backup
+    if (newBlock || currentNodeConnection.isLocalNode())
+        return NODE_POLL_NEW_BLOCK_MS;
+    return NODE_POLL_RUNNING_MS;
+}
 
-        if (timerCounter%div == 0) {
-            requestNodeInfo();
-        }
-    }
+void NodeInfo::onMwcTipHeightChanged(int height) {
+    // Interested in new blocks for synced node only. Sync progress is polled frequently anyway.
+    if ( !currentNodeConnection.isLocalNode() || !lastNodeStatus.online || height <= lastNodeStatus.nodeHeight ||
+            lastNodeStatus.nodeHeight < lastNodeStatus.peerHeight - 3 )
+        return;
+
+    if (pollTimer->remainingTime() > NODE_POLL_TIP_CHANGED_MS)
+        pollTimer->start(NODE_POLL_TIP_CHANGED_MS);
 }
 
 void NodeInfo::requestWalletResync() {
@@ -140,7 +153,8 @@ void NodeInfo::requestWalletResync() {
 }
 
 void NodeInfo::requestNodeInfo() {
-    context->wallet->getNodeStatus();
+    // The only poller, must get the real data
+    context->wallet->getNodeStatus(false);
 }
 
 wallet::MwcNodeConnection NodeInfo::getNodeConnection() const {
@@ -193,7 +207,14 @@ void NodeInfo::onNodeStatus( bool online, QString errMsg, int nodeHeight, int pe
         }
     }
 
+    const bool newBlock = online && lastNodeStatus.online && nodeHeight > lastNodeStatus.nodeHeight;
     lastNodeStatus.setData(online, errMsg, nodeHeight, peerHeight, totalDifficulty, connections);
+    // Status can be the respond to somebody else request, it can only make the next poll sooner
+    const int interval = calcPollInterval(newBlock);
+    if (pollRequested || !pollTimer->isActive() || pollTimer->remainingTime() > interval) {
+        pollRequested = false;
+        pollTimer->start(interval);
+    }
 
     if (justLogin) {
         justLogin = false;
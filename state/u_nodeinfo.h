@@ -19,8 +19,19 @@
 #include "../wallet/wallet.h"
 #include "../node/MwcNodeConfig.h"
 
+class QTimer;
+
 namespace state {
 
+// Node status polling intervals. Node status is polled by NodeInfo only, the rest are getting the shared results.
+const int NODE_POLL_WAIT_LOGIN_MS  = 3*1000;  // Wallet is not ready yet
+const int NODE_POLL_SYNC_MS        = 3*1000;  // Node is syncing, user is watching the progress
+const int NODE_POLL_RUNNING_MS     = 9*1000;  // Synced node, waiting for the next block
+const int NODE_POLL_NEW_BLOCK_MS   = 30*1000; // Block just arrived, next one is expected in about a minute
+const int NODE_POLL_OFFLINE_MS     = 15*1000; // Offline node or no peers, polling often doesn't help
+const int NODE_POLL_CLOUD_MS       = 60*1000; // Public node is reliable and we don't want to load it
+const int NODE_POLL_TIP_CHANGED_MS = 1000;    // Embedded node got a new block. Let mwc713 see it first
+
 struct NodeStatus {
     bool online = false;
     QString errMsg;
@@ -55,6 +66,8 @@ public:
     void updateNodeConnection( const wallet::MwcNodeConnection & nodeConnect);
 
     QString getMwcNodeStatus();
+    // Embedded node sync phases with durations and rates
+    QString getMwcNodeSyncHistory();
 
     node::MwcNode * getMwcNode() const;
 
@@ -80,13 +93,18 @@ private slots:
 
     void onSubmitFile(bool success, QString message, QString fileName);
 
+    void onMwcTipHeightChanged(int height);
+    void onPollTimer();
+
 private:
-    virtual void timerEvent(QTimerEvent *event) override;
+    // Next poll interval from the last known node status
+    int calcPollInterval(bool newBlock) const;
 private:
     bool  justLogin = false;
     NodeStatus lastNodeStatus; // Satus as mwc713 see the node
     QString lastLocalNodeStatus = "Waiting"; // Status from the embedded node
-    int timerCounter = 0; // update is different in different modes.
+    QTimer * pollTimer = nullptr; // Single node status poller, interval is adjusted to the node state
+    bool     pollRequested = false; // Waiting for the respond to our poll
     wallet::MwcNodeConnection currentNodeConnection;
 };
 
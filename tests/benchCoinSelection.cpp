@@ -0,0 +1,134 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchCoinSelection.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include "../util/coinselection.h"
+
+// Selection is allowed to be late because the budget is checked periodically
+#define BENCH_BUDGET_TOLERANCE_MS 20
+// Sets up to that size are validated with the full search
+#define BENCH_FULL_SEARCH_SIZE 14
+#define BENCH_FULL_SEARCH_RUNS 200
+
+namespace test {
+
+using namespace wallet;
+
+static const int64_t nano = 1000000000L;
+
+static WalletOutput createOutput(int idx, int64_t valueNano, double weight) {
+    WalletOutput out = WalletOutput::create( "c" + QString::number(idx), -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, valueNano, idx );
+    out.weight = weight;
+    return out;
+}
+
+// Mining wallet: 2/3 are same coinbase rewards, the rest are random payments
+static QVector<WalletOutput> generateOutputs(int outputsNumber, bool weighted) {
+    QVector<WalletOutput> outputs;
+    for (int i=0; i<outputsNumber; i++) {
+        int64_t value = (i%3) ? nano * 6 / 10 : int64_t(qrand() % 100000) * nano / 1000 + 1;
+        double weight = weighted ? 1.0 + (qrand() % 5) : 1.0;
+        outputs.push_back( createOutput(i, value, weight) );
+    }
+    return outputs;
+}
+
+// Best weighted value with the full search. Return -1 if there is no solution
+static double fullSearch(int64_t nanoCoins, const QVector<WalletOutput> & outputs) {
+    double best = -1.0;
+    for (int mask=1; mask < (1<<outputs.size()); mask++) {
+        int64_t total = 0;
+        double weighted = 0.0;
+        for (int i=0; i<outputs.size(); i++) {
+            if (mask & (1<<i)) {
+                total += outputs[i].valueNano;
+                weighted += outputs[i].getWeightedValue();
+            }
+        }
+        if (total >= nanoCoins && (best<0.0 || weighted < best))
+            best = weighted;
+    }
+    return best;
+}
+
+static bool validateSmallSets() {
+    for (int run=0; run<BENCH_FULL_SEARCH_RUNS; run++) {
+        QVector<WalletOutput> outputs;
+        int64_t total = 0;
+        int sz = qrand() % BENCH_FULL_SEARCH_SIZE + 1;
+        for (int i=0; i<sz; i++) {
+            outputs.push_back( createOutput(i, qrand() % 1000 + 1, 0.5 * (qrand() % 5 + 1)) );
+            total += outputs.last().valueNano;
+        }
+        int64_t amount = qrand() % total + 1;
+
+        util::CoinSelectionResult res = util::selectCoins(amount, outputs);
+        double best = fullSearch(amount, outputs);
+        if ( !res.ok || res.total < amount || res.weightedValue > best * (1.0 + 1e-9) ) {
+            qDebug() << "Coin selection is not optimal for amount " << amount << " and " << sz << " outputs. Found "
+                     << res.weightedValue << ", expected " << best;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool benchOutputs(const QString & name, const QVector<WalletOutput> & outputs) {
+    int64_t total = 0;
+    for (const auto & out : outputs)
+        total += out.valueNano;
+
+    QVector<int64_t> amounts{ outputs[outputs.size()/2].valueNano, total/1000, total/100, total/10, total/2, total - total/10 };
+
+    bool ok = true;
+    for (int64_t amount : amounts) {
+        QElapsedTimer timer;
+        timer.start();
+        util::CoinSelectionResult res = util::selectCoins(amount, outputs);
+        qint64 ms = timer.elapsed();
+
+        qDebug().noquote() << name << ": amount=" << amount << " ms=" << ms << " nodes=" << res.nodes << " outputs=" << res.selected.size()
+                 << " change=" << (res.total - amount) << " weighted=" << qint64(res.weightedValue) << " optimal=" << res.optimal;
+
+        if (!res.ok || res.total < amount) {
+            qDebug() << "Coin selection failed for amount " << amount;
+            ok = false;
+        }
+        if (ms > util::COIN_SELECTION_TIME_BUDGET_MS + BENCH_BUDGET_TOLERANCE_MS) {
+            qDebug() << "Coin selection is out of time budget for amount " << amount;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool benchCoinSelection(int outputsNumber) {
+    // Constant seed to reproduce
+    qsrand(5713);
+
+    if (!validateSmallSets())
+        return false;
+
+    if (outputsNumber<=0)
+        return true;
+
+    bool ok = benchOutputs( "same weights", generateOutputs(outputsNumber, false) );
+    ok = benchOutputs( "HODL weights", generateOutputs(outputsNumber, true) ) && ok;
+    return ok;
+}
+
+}
@@ -0,0 +1,28 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_BENCHCOINSELECTION_H
+#define MWC_QT_WALLET_BENCHCOINSELECTION_H
+
+namespace test {
+
+// Run coin selection for the generated mining wallet (many same coinbase outputs plus random ones).
+// Report time, visited nodes and change for different amounts. Small sets are validated with a full search.
+// Return false if selection result is wrong or it took much longer than the time budget.
+// Run it with: mwc-qt-wallet --bench_coins <outputs number>
+bool benchCoinSelection(int outputsNumber);
+
+}
+
+#endif //MWC_QT_WALLET_BENCHCOINSELECTION_H
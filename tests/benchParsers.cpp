@@ -0,0 +1,188 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchParsers.h"
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "../tries/mwc713inputparser.h"
+#include "../tries/NodeOutputParser.h"
+
+// Regression threshold, slower than 80% of the baseline is a failure
+#define BENCH_REGRESSION_RATIO 0.8
+// Every parser replays the transcript at least that long
+#define BENCH_MIN_TIME_MS 1000
+// mwc713 stdout comes in chunks, replaying the same way
+#define BENCH_CHUNK_SIZE 4096
+
+namespace test {
+
+using namespace tries;
+
+struct BenchResult {
+    qint64  chars = 0;
+    qint64  events = 0;
+    qint64  nsecs = 0;
+    quint64 poolCreated = 0;
+    quint64 poolReused = 0;
+
+    double charsPerSec() const { return nsecs>0 ? chars * 1e9 / nsecs : 0.0; }
+    double eventsPerSec() const { return nsecs>0 ? events * 1e9 / nsecs : 0.0; }
+};
+
+// Transcript lines looks like: '17.10.2020 11:14:33.125 mwc713>> Wallet Outputs - Account 'default' - Block Height: 418337'
+// Logger drops new lines, so restoring them.
+static bool loadTranscript( const QString & fileName, QVector<QString> & mwc713Chunks, QVector<QString> & nodeChunks ) {
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        qDebug() << "Unable to open transcript file " << fileName;
+        return false;
+    }
+
+    const QString mwc713Prefix(" mwc713>> ");
+    const QString nodePrefix(" mwc-node>> ");
+
+    QString mwc713Out, nodeOut;
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        int idx = line.indexOf(mwc713Prefix);
+        if (idx>=0) {
+            mwc713Out += line.mid(idx + mwc713Prefix.length()) + "\n";
+            continue;
+        }
+        idx = line.indexOf(nodePrefix);
+        if (idx>=0) {
+            nodeOut += line.mid(idx + nodePrefix.length()) + "\n";
+        }
+    }
+
+    for (int pos=0; pos<mwc713Out.length(); pos+=BENCH_CHUNK_SIZE)
+        mwc713Chunks.push_back( mwc713Out.mid(pos, BENCH_CHUNK_SIZE) );
+    for (int pos=0; pos<nodeOut.length(); pos+=BENCH_CHUNK_SIZE)
+        nodeChunks.push_back( nodeOut.mid(pos, BENCH_CHUNK_SIZE) );
+
+    return true;
+}
+
+// Replay chunks until BENCH_MIN_TIME_MS passed
+static BenchResult replay( InputParser & parser, const QVector<QString> & chunks ) {
+    BenchResult res;
+    if (chunks.isEmpty())
+        return res;
+
+    TrieAllocStats startStats = parser.getAllocStats();
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        for (const QString & ch : chunks) {
+            res.events += parser.processInput(ch).size();
+            res.chars += ch.length();
+        }
+    } while ( timer.elapsed() < BENCH_MIN_TIME_MS );
+    res.nsecs = timer.nsecsElapsed();
+
+    TrieAllocStats endStats = parser.getAllocStats();
+    res.poolCreated = endStats.created - startStats.created;
+    res.poolReused = endStats.reused - startStats.reused;
+    return res;
+}
+
+static void report( const QString & name, const BenchResult & res ) {
+    qDebug().noquote() << name << ": chars/sec=" << qint64(res.charsPerSec()) << " events/sec=" << qint64(res.eventsPerSec())
+             << " poolCreated=" << res.poolCreated << " poolReused=" << res.poolReused;
+}
+
+static qint64 singlePass( InputParser & parser, const QVector<QString> & chunks ) {
+    qint64 events = 0;
+    for (const QString & ch : chunks)
+        events += parser.processInput(ch).size();
+    return events;
+}
+
+// Return false if engines produce different number of events
+static bool benchParser( const QString & name, InputParser & referenceParser, InputParser & mergedParser,
+                         const QVector<QString> & chunks, QJsonObject & results ) {
+    referenceParser.setMergedEngine(false);
+    mergedParser.setMergedEngine(true);
+
+    // First pass is warming up the pools and checking that engines agree
+    qint64 refEvents = singlePass(referenceParser, chunks);
+    qint64 mergedEvents = singlePass(mergedParser, chunks);
+    if ( refEvents != mergedEvents ) {
+        qDebug() << "Engines produce different number of events for " << name << ": " << refEvents << " vs " << mergedEvents;
+        return false;
+    }
+
+    BenchResult reference = replay(referenceParser, chunks);
+    BenchResult merged = replay(mergedParser, chunks);
+
+    report( name + " reference", reference );
+    report( name + " merged", merged );
+
+    results[name + "_reference_chars_per_sec"] = reference.charsPerSec();
+    results[name + "_merged_chars_per_sec"] = merged.charsPerSec();
+    return true;
+}
+
+bool benchParsers(const QString & transcriptFile, const QString & baselineFile) {
+    QVector<QString> mwc713Chunks, nodeChunks;
+    if (!loadTranscript(transcriptFile, mwc713Chunks, nodeChunks))
+        return false;
+
+    QJsonObject results;
+    bool ok = true;
+    {
+        Mwc713InputParser referenceParser, mergedParser;
+        ok = benchParser( "mwc713", referenceParser.getInputParser(), mergedParser.getInputParser(), mwc713Chunks, results ) && ok;
+    }
+    {
+        NodeOutputParser referenceParser, mergedParser;
+        ok = benchParser( "mwc-node", referenceParser.getInputParser(), mergedParser.getInputParser(), nodeChunks, results ) && ok;
+    }
+
+    if (baselineFile.isEmpty())
+        return ok;
+
+    QFile file(baselineFile);
+    if (!file.exists()) {
+        if ( !file.open(QFile::WriteOnly) ) {
+            qDebug() << "Unable to write baseline file " << baselineFile;
+            return false;
+        }
+        file.write( QJsonDocument(results).toJson() );
+        qDebug() << "Baseline is saved into " << baselineFile;
+        return ok;
+    }
+
+    if ( !file.open(QFile::ReadOnly) ) {
+        qDebug() << "Unable to read baseline file " << baselineFile;
+        return false;
+    }
+    QJsonObject baseline = QJsonDocument::fromJson( file.readAll() ).object();
+    for ( auto key : results.keys() ) {
+        double base = baseline.value(key).toDouble(0.0);
+        double current = results.value(key).toDouble();
+        if ( base>0.0 && current < base * BENCH_REGRESSION_RATIO ) {
+            qDebug() << "Regression for " << key << ": " << current << " vs baseline " << base;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+}
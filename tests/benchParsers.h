@@ -0,0 +1,33 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_BENCHPARSERS_H
+#define MWC_QT_WALLET_BENCHPARSERS_H
+
+#include <QString>
+
+namespace test {
+
+// Replay recorded transcript through Mwc713InputParser and NodeOutputParser with both trie engines.
+// Report chars/sec, events/sec and allocations.
+// transcriptFile - mwc-qt-wallet log file. 'mwc713>>' and 'mwc-node>>' lines are replayed.
+// baselineFile   - optional. If exist, throughput is compared with it. If not exist, it is created.
+// Return false if engines disagree or throughput regressed against the baseline.
+// Run it with: mwc-qt-wallet --bench_parsers <transcript> [<baseline>]
+bool benchParsers(const QString & transcriptFile, const QString & baselineFile);
+
+}
+
+
+#endif //MWC_QT_WALLET_BENCHPARSERS_H
@@ -73,12 +73,12 @@ static void dotest_calcOutputsToSpend() {
     //
     {
         QVector<wallet::WalletOutput> outputs{
-                WalletOutput::create("c1000", "", "", "", "Unspent", false, "", 1000L, 1L),
-                WalletOutput::create("c2000", "", "", "", "Unspent", false, "", 2000L, 1L),
-                WalletOutput::create("c4000", "", "", "", "Unspent", false, "", 4000L, 1L),
-                WalletOutput::create("c8000", "", "", "", "Unspent", false, "", 8000L, 1L),
-                WalletOutput::create("c16000", "", "", "", "Unspent", false, "", 16000L, 1L),
-                WalletOutput::create("c32000", "", "", "", "Unspent", false, "", 32000L, 1L)
+                WalletOutput::create("c1000", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 1000L, 1L),
+                WalletOutput::create("c2000", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 2000L, 1L),
+                WalletOutput::create("c4000", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 4000L, 1L),
+                WalletOutput::create("c8000", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 8000L, 1L),
+                WalletOutput::create("c16000", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 16000L, 1L),
+                WalletOutput::create("c32000", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 32000L, 1L)
         };
 
         for (auto & o : outputs )
@@ -117,7 +117,7 @@ static void dotest_calcOutputsToSpend() {
         // test for the bunch of same items
         QVector<wallet::WalletOutput> outputs;
         for (int t=0;t<1000;t++) {
-            outputs.push_back( WalletOutput::create("c1000", "", "", "", "Unspent", false, "", 1000L, 1L));
+            outputs.push_back( WalletOutput::create("c1000", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 1000L, 1L));
         }
         runForTestSet( 1L, outputs, {"c1000"} );
         runForTestSet( 1900L, outputs, {"c1000","c1000"} );
@@ -141,7 +141,7 @@ static void dotest_calcOutputsToSpend() {
         for ( int i=0; i<outputNum; i++ ) {
             int64_t amount = (qrand() % 1000) * 10000 + i;
 
-            outputs.push_back( WalletOutput::create( QString::number(amount), "", "", "", "Unspent", false, "", amount, 1L));
+            outputs.push_back( WalletOutput::create( QString::number(amount), -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, amount, 1L));
             outputs[i].weight = 1.0;
         }
 
@@ -191,14 +191,14 @@ static void dotest_getOutputsToSend() {
     };
 
     QVector<wallet::WalletOutput> walletOutputs{
-        WalletOutput::create("10", "", "", "", "Unspent", false, "", 10*nano, 1L), // in hodl
-        WalletOutput::create("90", "", "", "", "Unspent", false, "", 90*nano, 1L), // in hodl
-        WalletOutput::create("20", "", "", "", "Unspent", false, "", 20*nano, 1L),
-        WalletOutput::create("30", "", "", "", "Unspent", false, "", 30*nano, 1L),
+        WalletOutput::create("10", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 10*nano, 1L), // in hodl
+        WalletOutput::create("90", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 90*nano, 1L), // in hodl
+        WalletOutput::create("20", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 20*nano, 1L),
+        WalletOutput::create("30", -1, -1, -1, WalletOutput::STATUS::UNSPENT, false, 0, 30*nano, 1L),
     };
 
     hodl.setHodlOutputs("", true, hodlOutputs, "errKey" );
-    mwc713.setWalletOutputs( "Bob", walletOutputs);
+    mwc713.setWalletOutputs( "Bob", 0, walletOutputs);
 
     QStringList resultOutputs;
 
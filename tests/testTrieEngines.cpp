@@ -0,0 +1,209 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testTrieEngines.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <algorithm>
+#include "../tries/mwc713inputparser.h"
+#include "../tries/NodeOutputParser.h"
+
+namespace test {
+
+using namespace tries;
+
+// Number of fuzzing rounds per parser
+#define FUZZ_ROUNDS 300
+// Lines per round
+#define FUZZ_LINES  40
+
+// Typical mwc713 output. Covers single active context (errors), START_NEXT_EVERY_TRY (account names)
+// and accumulate ids.
+static const QStringList mwc713Samples = {
+    "<<+)mwc713(+>>",
+    "Welcome to wallet713 for MWC v4.1.0",
+    "ERROR: another error: API error: not able to connect",
+    "WARNING: mwcmqs listener [xmjJGkX9U75Vo8Ro26gTm2i4k4CD39Q24qvQqAPeQVeWuo36YVFh] lost connection. Will try to restore in the background. tid=[ToMFBchztyUT0OgPTzeK6]",
+    "INFO: mwcmqs listener [xmjJGkX9U75Vo8Ro26gTm2i4k4CD39Q24qvQqAPeQVeWuo36YVFh] reestablished connection. tid=[ToMFBchztyUT0OgPTzeK6]",
+    "Error code: 500 Internal Server Error; Description: failed: Internal error: Failed to update pool",
+    "Your mwcmqs address: xmjJGkX9U75Vo8Ro26gTm2i4k4CD39Q24qvQqAPeQVeWuo36YVFh",
+    "Derived with index [7]",
+    "mwcmqs listener started for [xmjJGkX9U75Vo8Ro26gTm2i4k4CD39Q24qvQqAPeQVeWuo36YVFh] tid=[xa5ktaMRCEmj151Rfxr7a]",
+    "listener started for [keybase]",
+    "Tor listener started for [http://qx4szwqcqtzo4e9krca357hskg53pjh2uxhsdo854updvmr3o4msc3qd.onion]",
+    "Checking 1000 outputs, up to index 13433. (Highest index: 12235)",
+    "Checking 16 blocks, Height: 331630 - 331645, 22% complete",
+    "Scanning Complete",
+    "____ Wallet Summary Info - Account 'it's default' as of height 418337 ____",
+    "slate [5a759d16-f6b1-41d4-8d44-49307a50e09a] received from [xmgcJYZG6eG5ajHdZZGh8gXv5Ne4rdArrKwpSajQGhenUXdJQA5V] for [0.111000000] MWCs. Message: [\"L to r 0.111 mwc\"]",
+    "slate [b2822262-4760-4907-923f-e2459ed5d554] received from [jbyrer] for [1.000000000] MWCs.",
+    "Wallet Outputs - Account 'default' - Block Height: 418337",
+    "Transaction Log - Account 'acc ' - Block Height: 418337",
+    " 08d1b2c8a0cbf2e5b4c1c71b8d7c97d6ae72c2a0e66d83cd2c4bd6d1c9ffc7a8c6  417004        418341   Unspent  false        1338         1.000000000  10",
+    " 1   a6ef8e5c-0d3c-4a31-9d2b-0c0c5d2e3f36  Received Tx  2020-10-17 11:14:33  true  2020-10-17 11:15:02  1  0  1.000000000",
+    "You get an offer to swap BTC to MWC. SwapID is 8f2c3a0e-9c9f-4f4e-8b0a-2ad1b2c3d4e5",
+    "Incoming funds will be received in account: 'default'",
+};
+
+// Typical mwc-node output
+static const QStringList nodeSamples = {
+    "20191011 17:33:27.495 WARN grin_servers::grin::server - MWC server started.",
+    "20191011 19:13:56.842 INFO grin_servers::grin::sync::syncer - Waiting for the peers",
+    "20191011 22:43:38.969 DEBUG grin_chain::chain - init: sync_head: 365479725 @ 117749 [0099c40fb902]",
+    "20191011 17:58:38.254 INFO grin_servers::common::adapters - Received 32 block headers from 3.226.135.253:13414, height 117345",
+    "20191011 17:59:10.411 INFO grin_p2p::peer - Asking 3.226.135.253:13414 for txhashset archive at 114586 0a78e3f9d6c5.",
+    "20191011 17:59:14.101 INFO grin_p2p::protocol - handle_payload: txhashset archive for 0a78e3f9d6c5 at 114586. size=128918334",
+    "20191011 18:05:07.045 INFO grin_chain::txhashset::txhashset - txhashset: verify_rangeproofs: verified 72000 rangeproofs",
+    "20191011 18:07:37.377 INFO grin_chain::txhashset::txhashset - txhashset: verify_kernel_signatures: verified 61000 signatures",
+    "20191011 18:09:52.536 INFO grin_servers::common::adapters - Received block 140e019e22d0 at 114601 from 52.13.204.202:13414 [in/out/kern: 0/1/1] going to process.",
+    "20191011 18:15:44.002 INFO grin_servers::grin::sync::syncer - synchronized at 365444412 @ 117485 [0d4879faafaa]",
+    "20191011 18:16:01.000 INFO grin_servers::common::hooks - Received block 2a695957b396 at 102204 from 34.238.121.224:13414 [in/out/kern: 0/1/1] going to process.",
+    "20191011 18:17:00.000 WARN grin_servers::grin::sync::syncer - sync: no peers available, disabling sync",
+    "ERROR grin_servers::grin::server - P2P server failed with erorr: Connection(Os { code: 48, kind: AddrInUse, message: \"Address already in use\" })",
+    "20191011 18:18:00.000 DEBUG grin_p2p::peers - not relevant line that parsers should skip",
+};
+
+// Symbols that are interesting for the parsers, plus non Latin1 to hit the fallback path
+static const QString fuzzAlphabet = QString("abcXYZ019 '[]().,:;|-_@/\n\r\t") + QChar(0x00E9) + QChar(0x0416) + QChar(0x4E2D);
+
+static QChar randomChar() {
+    return fuzzAlphabet[qrand() % fuzzAlphabet.length()];
+}
+
+static QString mutateLine(QString line) {
+    int mutations = qrand() % 4;
+    for (int m=0; m<mutations && !line.isEmpty(); m++) {
+        int pos = qrand() % line.length();
+        switch (qrand() % 5) {
+            case 0: line.insert(pos, randomChar()); break;
+            case 1: line.remove(pos, 1 + qrand() % 3); break;
+            case 2: line[pos] = randomChar(); break;
+            case 3: line = line.left(pos); break; // truncated line
+            default: line.insert(pos, line.mid(qrand() % line.length(), 10)); break; // self splice
+        }
+    }
+    return line;
+}
+
+static QString generateInput(const QStringList & samples) {
+    QString input;
+    for (int l=0; l<FUZZ_LINES; l++) {
+        int kind = qrand() % 10;
+        if (kind < 5)
+            input += samples[qrand() % samples.size()];
+        else if (kind < 8)
+            input += mutateLine( samples[qrand() % samples.size()] );
+        else {
+            // Random garbage
+            int len = qrand() % 60;
+            for (int t=0; t<len; t++)
+                input += randomChar();
+        }
+        // Lines are not always terminated the same way
+        switch (qrand() % 4) {
+            case 0: input += "\n"; break;
+            case 1: input += "\r\n"; break;
+            case 2: input += "\n\n"; break;
+            default: break;
+        }
+    }
+    return input;
+}
+
+// Feed the input with random chunking
+static QVector<ParsingResult> parseInChunks(InputParser & parser, const QString & input, qint64 & nsecs) {
+    QVector<ParsingResult> result;
+    QElapsedTimer timer;
+    int pos = 0;
+    while (pos < input.length()) {
+        int len = 1 + qrand() % 512;
+        QString chunk = input.mid(pos, len);
+        timer.start();
+        result += parser.processInput(chunk);
+        nsecs += timer.nsecsElapsed();
+        pos += len;
+    }
+    return result;
+}
+
+static bool isEqual( const ParsingResult & r1, const ParsingResult & r2 ) {
+    if (r1.parserId != r2.parserId)
+        return false;
+    const QVector<SectionResult> & s1 = r1.result.parseResult;
+    const QVector<SectionResult> & s2 = r2.result.parseResult;
+    if (s1.size() != s2.size())
+        return false;
+    for (int t=0; t<s1.size(); t++) {
+        if (s1[t].dataId != s2[t].dataId || s1[t].strData != s2[t].strData)
+            return false;
+    }
+    return true;
+}
+
+// Return false if results are different
+static bool compareResults( const QString & name, const QString & input,
+                            const QVector<ParsingResult> & reference, const QVector<ParsingResult> & merged ) {
+    int sz = std::min( reference.size(), merged.size() );
+    for (int t=0; t<sz; t++) {
+        if (!isEqual(reference[t], merged[t])) {
+            qDebug() << name << " engines diverge at result " << t << ": " << reference[t] << " vs " << merged[t] << " for input: " << input;
+            return false;
+        }
+    }
+    if (reference.size() != merged.size()) {
+        qDebug() << name << " engines produce different number of results: " << reference.size() << " vs " << merged.size() << " for input: " << input;
+        return false;
+    }
+    return true;
+}
+
+template <class PARSER>
+static void fuzzParser( const QString & name, const QStringList & samples ) {
+    PARSER referenceParser, mergedParser;
+    referenceParser.getInputParser().setMergedEngine(false);
+    mergedParser.getInputParser().setMergedEngine(true);
+
+    qint64 referenceNs = 0, mergedNs = 0;
+    qint64 chars = 0, events = 0;
+
+    for (int round=0; round<FUZZ_ROUNDS; round++) {
+        QString input = generateInput(samples);
+        // Parsers keep the state between rounds, it is a part of the test
+        QVector<ParsingResult> reference = parseInChunks(referenceParser.getInputParser(), input, referenceNs);
+        QVector<ParsingResult> merged = parseInChunks(mergedParser.getInputParser(), input, mergedNs);
+
+        bool ok = compareResults(name, input, reference, merged);
+        Q_ASSERT(ok);
+        if (!ok)
+            return;
+
+        chars += input.length();
+        events += reference.size();
+    }
+
+    qDebug().noquote() << "testTrieEngines " << name << ": chars=" << chars << " events=" << events
+             << " reference chars/sec=" << (referenceNs>0 ? qint64(chars*1e9/referenceNs) : 0)
+             << " merged chars/sec=" << (mergedNs>0 ? qint64(chars*1e9/mergedNs) : 0);
+}
+
+void testTrieEngines() {
+    // Reproducible runs
+    qsrand(20201017);
+
+    fuzzParser<Mwc713InputParser>("mwc713", mwc713Samples);
+    fuzzParser<NodeOutputParser>("mwc-node", nodeSamples);
+}
+
+}
@@ -0,0 +1,27 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_TESTTRIEENGINES_H
+#define MWC_QT_WALLET_TESTTRIEENGINES_H
+
+namespace test {
+
+// Differential fuzzing of the trie engines. Random and mutated mwc713/mwc-node output is parsed by
+// the reference and merged engines with different chunking. Any divergence at ParsingResult
+// order or content is a failure. Throughput of both engines is reported.
+void testTrieEngines();
+
+}
+
+#endif //MWC_QT_WALLET_TESTTRIEENGINES_H
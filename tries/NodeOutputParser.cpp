@@ -148,6 +148,10 @@ NodeOutputParser::NodeOutputParser() {
                                                          new TriePhraseSection("Address already in use")
                                                  }));
 
+    // All parsers are registered. Merged engine skips the lines that can't be matched,
+    // that is most of the node output during the sync.
+    parser.setMergedEngine(true);
+
 
 }
 
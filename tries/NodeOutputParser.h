@@ -56,6 +56,9 @@ public:
     // Results will be delieved async through signals
     void processInput(QString message);
 
+    // Underlying parser. Used by benchmarks and tests to drive the engines directly
+    InputParser & getInputParser() {return parser;}
+
 private:
 signals:
      void nodeOutputGenericEvent( NODE_OUTPUT_EVENT event, QString message);
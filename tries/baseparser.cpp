@@ -45,11 +45,13 @@ void BaseTrieSection::appendNextParsers(BaseTrieSection * _nextParser) {
 }
 
 // Current section context
-TrieSectionContext::TrieSectionContext(BaseTrieSection * const _section, const LineResult & prevResult) :
-    prevParseResults(prevResult),
-    section(_section)
-{
+void TrieSectionContext::init(BaseTrieSection * _section, ResultNode * prevResult) {
+    Q_ASSERT(prevParseResults == nullptr);
+    section = _section;
+    prevParseResults = TrieContextPool::addRef(prevResult);
     accId = section->getAccumulateId();
+    accStr.resize(0); // keeping the buffer
+    sectionContext = TrieContext();
 }
 
 // return PROCESS_RESULT flags
@@ -64,11 +66,83 @@ uint32_t TrieSectionContext::processChar( QChar ch )
     return res;
 }
 
-LineResult TrieSectionContext::calcResult() const {
+ResultNode * TrieSectionContext::calcResult(TrieContextPool & pool) const {
     if (accId<0)
-        return prevParseResults;
+        return TrieContextPool::addRef(prevParseResults);
+
+    return pool.allocResult( SectionResult(accStr.left( std::max(accStr.size()-1,0) ) ,accId), prevParseResults );
+}
+
+TrieContextPool::~TrieContextPool() {
+    for (auto cnt : freeContexts)
+        delete cnt;
+    freeContexts.clear();
+
+    for (auto node : freeResults)
+        delete node;
+    freeResults.clear();
+}
+
+TrieSectionContext * TrieContextPool::allocContext(BaseTrieSection * section, ResultNode * prevResult) {
+    TrieSectionContext * context = nullptr;
+    if (freeContexts.isEmpty()) {
+        context = new TrieSectionContext();
+        stats.created++;
+    }
+    else {
+        context = freeContexts.takeLast();
+        stats.reused++;
+    }
+    context->init(section, prevResult);
+    return context;
+}
+
+void TrieContextPool::releaseContext(TrieSectionContext * context) {
+    releaseResult(context->prevParseResults);
+    context->prevParseResults = nullptr;
+    freeContexts.push_back(context);
+}
 
-    return LineResult(prevParseResults, SectionResult(accStr.left( std::max(accStr.size()-1,0) ) ,accId) );
+ResultNode * TrieContextPool::allocResult(SectionResult && result, ResultNode * prev) {
+    ResultNode * node = nullptr;
+    if (freeResults.isEmpty()) {
+        node = new ResultNode();
+        stats.created++;
+    }
+    else {
+        node = freeResults.takeLast();
+        stats.reused++;
+    }
+    node->result = std::move(result);
+    node->prev = addRef(prev);
+    node->refs = 1;
+    return node;
+}
+
+void TrieContextPool::releaseResult(ResultNode * node) {
+    while (node) {
+        Q_ASSERT(node->refs>0);
+        if (--node->refs > 0)
+            return;
+
+        ResultNode * prev = node->prev;
+        node->prev = nullptr;
+        node->result = SectionResult();
+        freeResults.push_back(node);
+        node = prev;
+    }
+}
+
+LineResult TrieContextPool::toLineResult(const ResultNode * node) {
+    int len = 0;
+    for (const ResultNode * n = node; n != nullptr; n = n->prev)
+        len++;
+
+    LineResult res;
+    res.parseResult.resize(len);
+    for (const ResultNode * n = node; n != nullptr; n = n->prev)
+        res.parseResult[--len] = n->result;
+    return res;
 }
 
 
@@ -81,7 +155,7 @@ TrieLineContext::~TrieLineContext() {
 
 void TrieLineContext::releaseData() {
     for (auto cnt : contexts) {
-        delete cnt;
+        pool.releaseContext(cnt);
     }
     contexts.clear();
 }
@@ -110,7 +184,7 @@ void TrieLineContext::processChar( BaseTrieSection * headSection, QChar ch ) {
         }
 
         // FAIL, DONE(not Keep) should be here
-        delete cont;
+        pool.releaseContext(cont);
         contexts.remove(i);
     }
 
@@ -118,7 +192,7 @@ void TrieLineContext::processChar( BaseTrieSection * headSection, QChar ch ) {
     if (isSingleActiveContext && !contexts.isEmpty())
         return;
 
-    startNewSectionAndProcess( headSection, LineResult(), ch );
+    startNewSectionAndProcess( headSection, nullptr, ch );
 }
 
 void TrieLineContext::processContext(TrieSectionContext* context, bool done, bool startNext, QChar ch) {
@@ -126,25 +200,31 @@ void TrieLineContext::processContext(TrieSectionContext* context, bool done, boo
     const QVector<BaseTrieSection*> & next = context->getNextSections();
 
     if (next.empty()) { // last in the chain - mean we can get results, but we can't spawn new sections
-        if ( done )
-            readyResult.push_back( context->calcResult() );
+        if ( done ) {
+            ResultNode * res = context->calcResult(pool);
+            readyResult.push_back( TrieContextPool::toLineResult(res) );
+            pool.releaseResult(res);
+        }
         return;
     }
 
+    // Result chain is shared by all next sections
+    ResultNode * res = context->calcResult(pool);
     if (startNext) {
         for (auto ns : next) {
-            startNewSectionAndProcess( ns, context->calcResult(), ch );
+            startNewSectionAndProcess( ns, res, ch );
         }
     }
     else {
         // Just append new sections
         for (auto ns : next) {
-            contexts.push_back( new TrieSectionContext(ns, context->calcResult()) );
+            contexts.push_back( pool.allocContext(ns, res) );
         }
     }
+    pool.releaseResult(res);
 }
 
-void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, LineResult && prevResult, QChar ch ) {
+void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, ResultNode * prevResult, QChar ch ) {
 
     { // preliminary test. Just test a symbol and discard if no match
         TrieContext tc;
@@ -157,7 +237,7 @@ void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, L
             return;
     }
 
-    TrieSectionContext * newContext = new TrieSectionContext(newSection, prevResult );
+    TrieSectionContext * newContext = pool.allocContext(newSection, prevResult );
     uint32_t res = newContext->processChar(ch);
 
     if ( res & (BaseTrieSection::PROCESS_RESULT::DONE | BaseTrieSection::PROCESS_RESULT::START_NEXT) ) {
@@ -172,8 +252,8 @@ void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, L
         return;
     }
 
-    // Seems like nobody need that. Deleting the context
-    delete newContext;
+    // Seems like nobody need that. Returning the context to the pool
+    pool.releaseContext(newContext);
 }
 
 
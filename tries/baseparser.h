@@ -89,27 +89,83 @@ protected:
     QVector<BaseTrieSection*> nextParser; // Next parsers in the chain. Can be many
 };
 
+// Immutable node of the results chain. Partial matches share their prefix results
+// through the chain instead of copying them. Nodes are owned by TrieContextPool.
+struct ResultNode {
+    SectionResult result;
+    ResultNode *  prev = nullptr; // Holds a reference
+    int           refs = 0;
+};
+
+// Counters for the pooled objects: section contexts and result nodes.
+// Note: QString/QVector buffers inside the contexts and results are not counted.
+struct TrieAllocStats {
+    quint64 created = 0; // pooled objects created because free lists were empty
+    quint64 reused = 0;  // pooled objects taken from the free lists
+
+    void add(const TrieAllocStats & other) { created += other.created; reused += other.reused; }
+};
+
+class TrieContextPool;
+
 // Current section context
 class TrieSectionContext {
 public:
-    TrieSectionContext(BaseTrieSection * const section, const LineResult & prevResult );
+    TrieSectionContext() = default;
+
+    TrieSectionContext(const TrieSectionContext&) = delete;
+    TrieSectionContext & operator=(const TrieSectionContext&) = delete;
+
+    // Init the context for a new section. Reference to prevResult is acquired.
+    void init(BaseTrieSection * section, ResultNode * prevResult);
 
     // return PROCESS_RESULT flags
     uint32_t processChar( QChar ch );
 
-    // Calculate results for current state
-    LineResult calcResult() const;
+    // Calculate results for current state. Caller owns a reference to the returned node.
+    ResultNode * calcResult(TrieContextPool & pool) const;
 
     const QVector<BaseTrieSection*> & getNextSections() const { return section->getNextParser(); }
 
 protected:
-    LineResult        prevParseResults;
-    BaseTrieSection * const section; // section related to the context.
-    int               accId;      // Accumulator ID. If negative - no accumulation need to be made.
-    QString           accStr;     // Accumulated String.
+    friend class TrieContextPool;
+
+    ResultNode *      prevParseResults = nullptr;
+    BaseTrieSection * section = nullptr; // section related to the context.
+    int               accId = -1;  // Accumulator ID. If negative - no accumulation need to be made.
+    QString           accStr;      // Accumulated String. Buffer is reused with the context.
     TrieContext       sectionContext;
 };
 
+// Arena for the contexts and results of a single TrieLineContext.
+// Released objects go to the free lists, so in steady state contexts and result nodes are not recreated.
+class TrieContextPool {
+public:
+    TrieContextPool() = default;
+    ~TrieContextPool();
+
+    TrieContextPool(const TrieContextPool&) = delete;
+    TrieContextPool & operator=(const TrieContextPool&) = delete;
+
+    TrieSectionContext * allocContext(BaseTrieSection * section, ResultNode * prevResult);
+    void releaseContext(TrieSectionContext * context);
+
+    // Create a new chain node. Reference to prev is acquired.
+    ResultNode * allocResult(SectionResult && result, ResultNode * prev);
+    static ResultNode * addRef(ResultNode * node) { if (node) node->refs++; return node; }
+    void releaseResult(ResultNode * node);
+
+    // Materialize the chain into the line result
+    static LineResult toLineResult(const ResultNode * node);
+
+    const TrieAllocStats & getStats() const {return stats;}
+private:
+    // Objects that are in use are owned by the TrieLineContext, pool owns only the free ones
+    QVector<TrieSectionContext*> freeContexts;
+    QVector<ResultNode*> freeResults;
+    TrieAllocStats stats;
+};
+
 // Context from the whole line
 class TrieLineContext {
 public:
@@ -124,17 +180,23 @@ public:
 
     void reset(); // Reset whole context
 
+    // true if some sections are in progress. Such context must be feed with every char
+    bool hasActiveContexts() const {return !contexts.isEmpty();}
+
     bool hasResults() const {return !readyResult.empty();}
     const QVector<LineResult> & getReadyResult() const {return readyResult;}
     // Clean up the result that we get from ready
     void resetResults() {readyResult.clear();}
+
+    const TrieAllocStats & getAllocStats() const {return pool.getStats();}
 private:
     void releaseData();
     void processContext(TrieSectionContext* context, bool done, bool startNext, QChar ch);
-    void startNewSectionAndProcess( BaseTrieSection * newSection, LineResult && prevResult, QChar ch );
+    void startNewSectionAndProcess( BaseTrieSection * newSection, ResultNode * prevResult, QChar ch );
 protected:
     bool isSingleActiveContext;
-    QVector< TrieSectionContext* > contexts; // owners those objects
+    TrieContextPool pool; // Must outlive the contexts
+    QVector< TrieSectionContext* > contexts; // allocated from the pool
     QVector<LineResult> readyResult;
 };
 
@@ -151,6 +213,8 @@ public:
     TrieLineParser & operator=(const TrieLineParser & other) = delete;
 
     int getParserId() const {return parserId;}
+    // First section in the chain. Every new match must be started from it.
+    BaseTrieSection * getHeadSection() const { return sections.isEmpty() ? nullptr : sections.front(); }
 
     // Adding section/line for parsing and pair them in chain
     TrieLineParser & addSection( BaseTrieSection* s );
@@ -44,6 +44,7 @@ InputParser::~InputParser() {
 // parser must be on the heap and pnership will be transferred to this
 void InputParser::appendLineParser( TrieLineParser* parser, bool hasSingleActiveContext ) {
     lines.push_back( LineInfo( parser, new TrieLineContext(hasSingleActiveContext) ) );
+    automatonValid = false;
 }
 
 bool InputParser::deleteLineParser(int parserId) {
@@ -55,34 +56,146 @@ bool InputParser::deleteLineParser(int parserId) {
             lines.remove(t);
         }
     }
+    if (lines.size() < sz)
+        automatonValid = false;
     return lines.size() < sz;
 }
 
+void InputParser::setMergedEngine(bool merged) {
+    mergedEngine = merged;
+    automatonValid = false;
+}
+
 QVector<ParsingResult> InputParser::processInput(QString input) {
     // processing input symbol by symbol
     int len = input.length();
 
     QVector<ParsingResult> result;
 
+    if (mergedEngine) {
+        if (!automatonValid)
+            buildAutomaton();
+
+        const ushort * data = input.utf16();
+        for ( int l=0; l<len; l++ ) {
+            // Nothing is in progress, jumping to the next possible match start
+            if (activeLines.isEmpty()) {
+                l = skipDeadInput(data, l, len);
+                if (l>=len)
+                    break;
+            }
+            processCharMerged( QChar(data[l]), result );
+        }
+        return result;
+    }
+
     for ( int l=0; l<len; l++ ) {
         QChar ch = input[l];
 
         for ( LineInfo & p : lines ) {
-            if (p.parser->process(ch, p.context))
-            { // get a result...
-                const QVector<LineResult> & res = p.context->getReadyResult();
-                for ( auto & r : res ) {
-                    result.push_back( ParsingResult(p.parser->getParserId(), r ) );
-                }
-                p.context->resetResults();
-
-                // not resetting statuses for the rest.
-                // Naturally reset should be atchieved.
-            }
+            processLine(p, ch, result);
         }
     }
     return result;
 }
 
+TrieAllocStats InputParser::getAllocStats() const {
+    TrieAllocStats stats;
+    for ( const LineInfo & p : lines )
+        stats.add( p.context->getAllocStats() );
+    return stats;
+}
+
+void InputParser::processLine( LineInfo & p, QChar ch, QVector<ParsingResult> & result ) {
+    if (p.parser->process(ch, p.context))
+    { // get a result...
+        const QVector<LineResult> & res = p.context->getReadyResult();
+        for ( auto & r : res ) {
+            result.push_back( ParsingResult(p.parser->getParserId(), r ) );
+        }
+        p.context->resetResults();
+
+        // not resetting statuses for the rest.
+        // Naturally reset should be atchieved.
+    }
+}
+
+// Line that has no active contexts and head section that fails on the char doesn't change
+// its state and doesn't produce any results. Because of that such lines can be skipped.
+// Lines are visited in the registration order, so results order is the same as reference engine has.
+void InputParser::processCharMerged( QChar ch, QVector<ParsingResult> & result ) {
+    const ushort code = ch.unicode();
+    const QVector<int> & startLines = code < START_TABLE_SIZE ? startTable[code] : allLines;
+
+    // Merging two sorted index lists
+    visitLines.resize(0);
+    int a = 0, b = 0;
+    const int aSz = activeLines.size(), bSz = startLines.size();
+    while ( a<aSz || b<bSz ) {
+        if (b>=bSz || (a<aSz && activeLines[a] < startLines[b]) )
+            visitLines.push_back( activeLines[a++] );
+        else if (a>=aSz || startLines[b] < activeLines[a] )
+            visitLines.push_back( startLines[b++] );
+        else {
+            visitLines.push_back( activeLines[a++] );
+            b++;
+        }
+    }
+
+    activeLines.resize(0);
+    for (int idx : visitLines) {
+        LineInfo & p = lines[idx];
+        processLine(p, ch, result);
+        if (p.context->hasActiveContexts())
+            activeLines.push_back(idx);
+    }
+}
+
+int InputParser::skipDeadInput( const ushort * data, int pos, int len ) const {
+    Q_ASSERT(activeLines.isEmpty());
+    // Unrolled by 4, most of mwc713 and mwc-node output is dead for the parsers
+    for ( ; pos+4 <= len; pos += 4 ) {
+        const ushort c0 = data[pos], c1 = data[pos+1], c2 = data[pos+2], c3 = data[pos+3];
+        if ( (c0 | c1 | c2 | c3) >= START_TABLE_SIZE ||
+             (startChars[c0] | startChars[c1] | startChars[c2] | startChars[c3]) != 0 )
+            break;
+    }
+    for ( ; pos < len; pos++ ) {
+        const ushort c = data[pos];
+        if ( c >= START_TABLE_SIZE || startChars[c] )
+            return pos;
+    }
+    return len;
+}
+
+void InputParser::buildAutomaton() {
+    for (int c=0; c<START_TABLE_SIZE; c++)
+        startTable[c].resize(0);
+    allLines.resize(0);
+    activeLines.resize(0);
+
+    for (int idx=0; idx<lines.size(); idx++) {
+        allLines.push_back(idx);
+
+        const LineInfo & p = lines[idx];
+        if (p.context->hasActiveContexts())
+            activeLines.push_back(idx);
+
+        BaseTrieSection * head = p.parser->getHeadSection();
+        Q_ASSERT(head);
+        for (int c=0; c<START_TABLE_SIZE; c++) {
+            // Same preliminary test as TrieLineContext::startNewSectionAndProcess does
+            TrieContext tc;
+            if ( head->processChar(tc, QChar(c)) != BaseTrieSection::PROCESS_RESULT::FAIL )
+                startTable[c].push_back(idx);
+        }
+    }
+
+    for (int c=0; c<START_TABLE_SIZE; c++)
+        startChars[c] = startTable[c].isEmpty() ? 0 : 1;
+
+    automatonValid = true;
+}
+
 
 }
@@ -64,10 +64,40 @@ public:
     // return true if anything was deleted
     bool deleteLineParser(int parserId);
 
+    // Switch between the engines. Both engines produce exactly the same results.
+    // Reference engine feeds every char to every line parser.
+    // Merged engine compiles head sections of all line parsers into a single start table,
+    // so every char is delivered only to the parsers that are in progress or can start with it.
+    // Cost of the merged engine depends on the input length, not on the number of parsers.
+    void setMergedEngine(bool merged);
+    bool isMergedEngine() const {return mergedEngine;}
+
     QVector<ParsingResult> processInput(QString input);
 
+    // Pooled objects counters from all line contexts. Steady state parsing is expected to reuse them only.
+    TrieAllocStats getAllocStats() const;
+
+private:
+    // Feed the char into the line and collect the results if any
+    void processLine( LineInfo & p, QChar ch, QVector<ParsingResult> & result );
+    void processCharMerged( QChar ch, QVector<ParsingResult> & result );
+    // Scan for the next char that can start any line. Valid only if no lines are active.
+    int skipDeadInput( const ushort * data, int pos, int len ) const;
+    // Build the start table for the merged engine.
+    void buildAutomaton();
+
 protected:
     QVector< LineInfo > lines;
+
+    // Merged engine data
+    enum { START_TABLE_SIZE = 256 }; // Latin1 range. Other chars are dispatched to all lines.
+    bool mergedEngine = false;
+    bool automatonValid = false;
+    QVector<int> startTable[START_TABLE_SIZE]; // For every Latin1 char - sorted indexes of the lines with head section that accept it
+    uchar startChars[START_TABLE_SIZE];        // 1 if startTable for the char is not empty
+    QVector<int> allLines;    // Indexes of all lines. Used for non Latin1 chars
+    QVector<int> activeLines; // Sorted indexes of the lines with active contexts
+    QVector<int> visitLines;  // Lines to process for the current char. Reused buffer
 };
 
 }
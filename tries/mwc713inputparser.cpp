@@ -38,6 +38,9 @@ Mwc713InputParser::Mwc713InputParser() {
     initRecovery();
     initSyncProgress();
     initSwaps();
+
+    // All parsers are registered, switching to the merged automaton.
+    parser.setMergedEngine(true);
 }
 
 Mwc713InputParser::~Mwc713InputParser() {}
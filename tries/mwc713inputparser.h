@@ -40,6 +40,9 @@ public:
     // Resilting will be delieved async through signals
     void processInput(QString message);
 
+    // Underlying parser. Used by benchmarks and tests to drive the engines directly
+    InputParser & getInputParser() {return parser;}
+
 private:
 
     // Register callbacks for event that we are going to process.
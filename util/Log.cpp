@@ -20,6 +20,9 @@
 #include <QDateTime>
 #include "../wallet/mwc713task.h"
 #include <QProcess>
+#include <QThread>
+#include <QTimer>
+#include <QMutex>
 #include "../core/Config.h"
 #include "../core/WndManager.h"
 
@@ -33,14 +36,62 @@
 namespace logger {
 
 static LogSender *   logClient = nullptr;
+// Logs are written from the GUI and the reader threads. Lock guards the receiver pointer as well,
+// so enableLogs(false) can't delete it in the middle of the write.
+static QMutex        logServerLock;
 static LogReceiver * logServer = nullptr;
 
-static bool logMwc713outBlocked = false;
+// mwc713 output is logged from the reader thread
+static QAtomicInt logMwc713outBlocked(0);
 
 const QString LOG_FILE_NAME = "mwcwallet.log";
 
+// Logger can fail at any thread that writes, while logs are locked. Message box is shown by the GUI thread.
+static void reportLogError(QString title, QString message, bool quit) {
+    auto report = [title, message, quit]() {
+        core::getWndManager()->messageTextDlg(title, message);
+        if (quit)
+            QApplication::quit();
+    };
+    if (QThread::currentThread() == QCoreApplication::instance()->thread())
+        report();
+    else
+        QTimer::singleShot(0, QCoreApplication::instance(), report);
+}
+
+// Archiving of the rotated file takes a while, other threads keep writing into the new file meanwhile.
+static void compressRotatedLogs(QMutexLocker & l) {
+    const QString rotated = logServer->takeRotatedFile();
+    if (rotated.isEmpty())
+        return;
+
+    const QString logPath = logServer->getLogPath();
+    const QString logFileName = logServer->getLogFileName();
+    l.unlock();
+    LogReceiver::compressRotatedFile(logPath, logFileName, rotated);
+}
+
+static void appendToLogs(bool addDate, QString prefix, QString line ) {
+    QMutexLocker l(&logServerLock);
+    if (logServer != nullptr) {
+        logServer->onAppend2logs(addDate, prefix, line);
+        compressRotatedLogs(l);
+    }
+}
+
+static void appendLinesToLogs(QString prefix, QStringList lines ) {
+    QMutexLocker l(&logServerLock);
+    if (logServer != nullptr) {
+        logServer->onAppendLines2logs(prefix, lines);
+        compressRotatedLogs(l);
+    }
+}
+
 void initLogger( bool logsEnabled) {
     logClient = new LogSender(true);
+    // Writing at the caller thread. logServer can be deleted by enableLogs, so it is not the receiver
+    QObject::connect( logClient, &LogSender::doAppend2logs, logClient, &appendToLogs, Qt::DirectConnection);
+    QObject::connect( logClient, &LogSender::doAppendLines2logs, logClient, &appendLinesToLogs, Qt::DirectConnection);
 
     enableLogs(logsEnabled);
 
@@ -62,19 +113,23 @@ void cleanUpLogs() {
 
 // enable/disable logs
 void enableLogs( bool enableLogs ) {
+    // Called from GUI thread only. The receiver is created outside of the lock, it might show the message box.
     if (enableLogs) {
         if (logServer != nullptr )
             return;
 
-        logServer = new LogReceiver(LOG_FILE_NAME);
-        QObject::connect( logClient, &LogSender::doAppend2logs, logServer, &LogReceiver::onAppend2logs, Qt::DirectConnection); // Qt::QueuedConnection );
+        LogReceiver * server = new LogReceiver(LOG_FILE_NAME);
+        QMutexLocker l(&logServerLock);
+        logServer = server;
     }
     else {
-        if (logServer == nullptr)
-            return;
-
-        delete logServer;
-        logServer = nullptr;
+        LogReceiver * server = nullptr;
+        {
+            QMutexLocker l(&logServerLock);
+            server = logServer;
+            logServer = nullptr;
+        }
+        delete server;
     }
 }
 
@@ -84,7 +139,7 @@ void LogSender::log(bool addDate, const QString & prefix, const QString & line)
         emit doAppend2logs(addDate, prefix, line);
     }
     else {
-        logServer->onAppend2logs(addDate, prefix, line );
+        appendToLogs(addDate, prefix, line );
     }
 }
 
@@ -101,8 +156,12 @@ LogReceiver::LogReceiver(const QString & filename) :
 
     logPath = path.second;
 
+    // Receiver is not published yet, nobody is waiting for the logs
     rotateLogFileIfNeeded();
     openLogFile();
+    QString rotated = takeRotatedFile();
+    if (!rotated.isEmpty())
+        compressRotatedFile(logPath, logFileName, rotated);
 }
 
 LogReceiver::~LogReceiver() {
@@ -118,6 +177,28 @@ void LogReceiver::rotateLogFileIfNeeded() {
 
     qDebug() << "Rotating logs file: " << logPathName;
 
+    bool logFileOpen = (logFile != nullptr);
+    if (logFile) {
+        delete logFile;
+        logFile = nullptr;
+    }
+
+    // Writing continue into the new file, the old one is renamed and waits for compression
+    const QString rotatedFn = "rotated_" + QDateTime::currentDateTime().toString("yyyy_MM_dd_hh_mm_ss_zzz") + "_" + logFileName;
+    if (QDir(logPath).rename(logFileName, rotatedFn))
+        rotatedFile = rotatedFn;
+
+    if (logFileOpen)
+        openLogFile();
+}
+
+QString LogReceiver::takeRotatedFile() {
+    QString res = rotatedFile;
+    rotatedFile.clear();
+    return res;
+}
+
+void LogReceiver::compressRotatedFile(QString logPath, QString logFileName, QString rotatedFileName) {
     // First check if need to clean up
     QStringList archives = QDir(logPath).entryList( {"*.zip"} );
     if (archives.size()>LOG_FILES_POOL_SIZE) {
@@ -130,17 +211,11 @@ void LogReceiver::rotateLogFileIfNeeded() {
         }
     }
 
-    bool logFileOpen = (logFile != nullptr);
-    if (logFile) {
-        delete logFile;
-        logFile = nullptr;
-    }
-
     // Generate the file name
     QDateTime  now = QDateTime::currentDateTime();
     QString archiveFileName = now.toString("yyyy_MM_dd_hh_mm_ss_zzz")+".zip";
 
-    QString srcFileName = logPath + "/" + logFileName;
+    QString srcFileName = logPath + "/" + rotatedFileName;
     QString resultFileName = logPath + "/" + archiveFileName;
 
     // Find the mwczip location. It is expected ta the same directory where mwc713 located
@@ -154,33 +229,33 @@ void LogReceiver::rotateLogFileIfNeeded() {
     QDir logDir( logPath );
 
     if (exitCode!=3) {
-        core::getWndManager()->messageTextDlg("Log files rotation", "Unable to rotate log file at "+ logPath +"\nYour previous file will be swapped with a new log data.");
+        reportLogError("Log files rotation", "Unable to rotate log file at "+ logPath +"\nYour previous file will be swapped with a new log data.", false);
         const QString prevLogFn = "prev_"+logFileName;
         logDir.remove(prevLogFn);
-        logDir.rename(logFileName, prevLogFn);
+        logDir.rename(rotatedFileName, prevLogFn);
     }
     else {
-        logDir.remove(logFileName);
+        logDir.remove(rotatedFileName);
     }
-
-    if (logFileOpen)
-        openLogFile();
 }
 
 void LogReceiver::openLogFile() {
     QString logFn = logPath + "/" + logFileName;
     logFile = new QFile(logFn);
     if (!logFile->open(QFile::WriteOnly | QFile::Append)) {
-        core::getWndManager()->messageTextDlg("Critical Error", "Unable to open the logger file: " + logPath);
-        QApplication::quit();
+        reportLogError("Critical Error", "Unable to open the logger file: " + logPath, true);
         return;
     }
 }
 
 
 void LogReceiver::onAppend2logs(bool addDate, QString prefix, QString line ) {
+    // Caller holds logServerLock
     counter++;
+    // Rotation is done by the thread that writes, so busy reader threads can't skip it.
+    // Here file is only renamed, caller compress it after the logs are unlocked.
     if (counter>10000) {
+        counter = 0;
         rotateLogFileIfNeeded();
     }
 
@@ -195,24 +270,47 @@ void LogReceiver::onAppend2logs(bool addDate, QString prefix, QString line ) {
     logFile->flush();
 }
 
+void LogReceiver::onAppendLines2logs(QString prefix, QStringList lines ) {
+    if (lines.isEmpty())
+        return;
+
+    // Caller holds logServerLock
+    counter += lines.size();
+    if (counter>10000) {
+        counter = 0;
+        rotateLogFileIfNeeded();
+    }
+
+    // Lines came together, one timestamp and one flush for all of them
+    const QString linePrefix = QDateTime::currentDateTime().toString("dd.MM.yyyy hh:mm:ss.zzz") + " " + prefix + " ";
+    QString logData;
+    for (const QString & ln : lines)
+        logData += linePrefix + ln + "\n";
+
+    logFile->write( logData.toUtf8() );
+    logFile->flush();
+}
+
 // Global methods that do logging
 
 void blockLogMwc713out(bool blockOutput) {
-    logMwc713outBlocked = blockOutput;
+    logMwc713outBlocked.storeRelease(blockOutput ? 1 : 0);
 }
 
 
 // mwc713 IOs
-void logMwc713out(QString str) {
+void logMwc713outLines(const QVector<QString> & lines) {
     Q_ASSERT(logClient); // call initLogger first
 
-    if (logMwc713outBlocked) {
+    if (lines.isEmpty())
+        return;
+
+    if (logMwc713outBlocked.loadAcquire()) {
         logClient->doAppend2logs(true, "mwc713>>", "CENSORED");
         return;
     }
 
-    auto lns = str.split(QRegExp("[\r\n]"),QString::SkipEmptyParts);
-    for (auto & l: lns) {
+    for (auto & l: lines) {
         logClient->doAppend2logs(true, "mwc713>>", l);
     }
 }
@@ -222,14 +320,12 @@ void logMwc713in(QString str) {
     logClient->doAppend2logs(true, "mwc713<<", str);
 }
 
-void logMwcNodeOut(QString str) {
+void logMwcNodeOutLines(const QStringList & lines) {
     Q_ASSERT(logClient);
+    if (lines.isEmpty())
+        return;
 
-    auto lns = str.split(QRegExp("[\r\n]"),QString::SkipEmptyParts);
-    for (auto & l: lns) {
-        logClient->doAppend2logs(true, "mwc-node>>", l);
-    }
-
+    logClient->doAppendLines2logs("mwc-node>>", lines);
 }
 
 
@@ -255,7 +351,7 @@ void logInfo(QString who, QString message) {
 
 void logParsingEvent(wallet::WALLET_EVENTS event, QString message ) {
     Q_ASSERT(logClient); // call initLogger first
-    if (logMwc713outBlocked) { // Skipping event during block pahse as well
+    if (logMwc713outBlocked.loadAcquire()) { // Skipping event during block pahse as well
         logClient->doAppend2logs(true, "Event>", "CENSORED" );
         return;
     }
@@ -16,6 +16,7 @@
 #define GUI_WALLET_LOG_H
 
 #include <QObject>
+#include <QStringList>
 #include "../wallet/mwc713events.h"
 #include "../tries/NodeOutputParser.h"
 
@@ -40,6 +41,8 @@ namespace logger {
 
     signals:
         void doAppend2logs(bool addDate, QString prefix, QString line );
+        // Batch of lines, written with a single flush
+        void doAppendLines2logs(QString prefix, QStringList lines );
     private:
         bool asyncLogging; // Use QT messaging or write directly. Direct writing might cause concurrency issues
     };
@@ -52,14 +55,28 @@ namespace logger {
 
     public slots:
         void onAppend2logs(bool addDate, QString prefix, QString line );
+        void onAppendLines2logs(QString prefix, QStringList lines );
+
+    public:
+        // File that was rotated by the last write and waits for compression. Empty if none
+        QString takeRotatedFile();
+        const QString & getLogPath() const {return logPath;}
+        const QString & getLogFileName() const {return logFileName;}
+
+        // Archive the rotated log file. Slow, must be called without holding the logs lock.
+        // Static because receiver can be deleted meanwhile.
+        static void compressRotatedFile(QString logPath, QString logFileName, QString rotatedFileName);
     private:
+        // Rename the log file if it is too large. Fast, compression is done by compressRotatedFile
         void rotateLogFileIfNeeded();
         void openLogFile();
     private:
         QString logPath;
         const QString logFileName;
         QFile * logFile = nullptr;
-        int counter = 0;
+        int counter = 0; // Lines since the last rotation check
+        QString rotatedFile; // Rotated file name, waiting for compression
+
     };
 
     // Must be call before first log usage
@@ -67,9 +84,9 @@ namespace logger {
 
     // mwc713 IOs
     void blockLogMwc713out(bool blockOutput);
-    void logMwc713out(QString str); //
+    void logMwc713outLines(const QVector<QString> & lines); // Lines are already split
     void logMwc713in(QString str); //
-    void logMwcNodeOut(QString str); //
+    void logMwcNodeOutLines(const QStringList & lines); // Lines are already split, written as a batch
 
     void logParsingEvent(wallet::WALLET_EVENTS event, QString message );
     void logNodeEvent( tries::NODE_OUTPUT_EVENT event, QString message );
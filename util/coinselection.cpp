@@ -0,0 +1,174 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "coinselection.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <limits>
+
+namespace util {
+
+// Relative precision for weighted values comparison. Weights are doubles, sums are accumulating the rounding errors.
+static const double COST_EPS = 1e-12;
+
+// Budget is checked every 4096 nodes, QElapsedTimer is not free
+static const int64_t TIME_CHECK_MASK = 0xFFF;
+
+CoinSelectionResult selectCoins( int64_t nanoCoins, const QVector<wallet::WalletOutput> & outputs, int64_t timeBudgetMs ) {
+    QElapsedTimer timer;
+    timer.start();
+
+    CoinSelectionResult result;
+
+    // At least one output is expected at the result
+    const int64_t target = std::max( nanoCoins, int64_t(1) );
+
+    // Any set with an output that covers the amount is not better than this output alone.
+    // So it is enough to find the best single output, the search is needed for smaller outputs only.
+    int bestSingle = -1;
+    double bestSingleCost = std::numeric_limits<double>::max();
+    QVector<int> items;
+    int64_t itemsTotal = 0;
+    for (int k=0; k<outputs.size(); k++) {
+        const wallet::WalletOutput & out = outputs[k];
+        if (out.valueNano >= target) {
+            if (out.getWeightedValue() < bestSingleCost) {
+                bestSingleCost = out.getWeightedValue();
+                bestSingle = k;
+            }
+        }
+        else if (out.valueNano > 0) {
+            items.push_back(k);
+            itemsTotal += out.valueNano;
+        }
+    }
+
+    if ( bestSingle<0 && itemsTotal<target )
+        return result; // not enough funds
+
+    // Larger first, so the first found solutions are small. Cheaper first for the same value.
+    std::sort( items.begin(), items.end(), [&outputs](int a, int b) {
+        const wallet::WalletOutput & oa = outputs[a];
+        const wallet::WalletOutput & ob = outputs[b];
+        if (oa.valueNano != ob.valueNano)
+            return oa.valueNano > ob.valueNano;
+        return oa.weight < ob.weight;
+    });
+
+    const int n = items.size();
+    QVector<int64_t> value(n);
+    QVector<double>  weight(n);
+    QVector<double>  cost(n);
+    // Suffix sums and min weights are giving the bounds for the rest of outputs
+    QVector<int64_t> suffixValue(n+1);
+    QVector<double>  suffixMinWeight(n+1);
+    suffixValue[n] = 0;
+    suffixMinWeight[n] = std::numeric_limits<double>::max();
+    for (int k=0; k<n; k++) {
+        const wallet::WalletOutput & out = outputs[items[k]];
+        value[k] = out.valueNano;
+        weight[k] = out.weight;
+        cost[k] = out.getWeightedValue();
+    }
+    for (int k=n-1; k>=0; k--) {
+        suffixValue[k] = suffixValue[k+1] + value[k];
+        suffixMinWeight[k] = std::min( suffixMinWeight[k+1], weight[k] );
+    }
+
+    // No solution can be better than that
+    double rootBound = bestSingleCost;
+    if (itemsTotal >= target)
+        rootBound = std::min( rootBound, double(target) * suffixMinWeight[0] );
+
+    double bestCost = bestSingleCost;
+    QVector<int> bestSelection; // indexes at items. Empty - bestSingle is the best
+    bool hasSolution = bestSingle>=0;
+    bool optimal = bestCost <= rootBound * (1.0 + COST_EPS);
+
+    if (!optimal) {
+        // Depth first search, include branch goes first. 'selection' is the path, included items in increasing order.
+        QVector<int> selection;
+        int64_t curValue = 0;
+        double  curCost = 0.0;
+        int i = 0;
+        optimal = true;
+
+        while (true) {
+            result.nodes++;
+            // Budget is applied after the first solution. The first one is the greedy path, it is found in O(n)
+            if ( hasSolution && (result.nodes & TIME_CHECK_MASK)==0 && timer.elapsed() > timeBudgetMs ) {
+                optimal = false;
+                break;
+            }
+
+            bool backtrack = false;
+            const int64_t need = target - curValue;
+            if (need <= 0) {
+                if (!hasSolution || curCost < bestCost) {
+                    hasSolution = true;
+                    bestCost = curCost;
+                    bestSelection = selection;
+                    if (bestCost <= rootBound * (1.0 + COST_EPS))
+                        break; // Can't be better
+                }
+                backtrack = true;
+            }
+            else if (suffixValue[i] < need) {
+                backtrack = true; // rest of outputs are not enough
+            }
+            else if (curCost + double(need) * suffixMinWeight[i] >= bestCost * (1.0 - COST_EPS)) {
+                backtrack = true; // rest of outputs can't make it better
+            }
+
+            if (!backtrack) {
+                selection.push_back(i);
+                curValue += value[i];
+                curCost += cost[i];
+                i++;
+                continue;
+            }
+
+            if (selection.isEmpty())
+                break; // All variants are checked
+
+            // Excluding the last included output
+            const int last = selection.takeLast();
+            curValue -= value[last];
+            curCost = selection.isEmpty() ? 0.0 : curCost - cost[last];
+            // Same outputs will produce the same subtrees, skipping them
+            i = last+1;
+            while ( i<n && value[i]==value[last] && weight[i]==weight[last] )
+                i++;
+        }
+    }
+
+    result.ok = true;
+    result.optimal = optimal;
+    if (bestSelection.isEmpty()) {
+        Q_ASSERT(bestSingle>=0);
+        result.selected.push_back(bestSingle);
+    }
+    else {
+        for (int k : bestSelection)
+            result.selected.push_back( items[k] );
+    }
+
+    for (int k : result.selected) {
+        result.total += outputs[k].valueNano;
+        result.weightedValue += outputs[k].getWeightedValue();
+    }
+    return result;
+}
+
+}
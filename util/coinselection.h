@@ -0,0 +1,42 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_COINSELECTION_H
+#define MWC_QT_WALLET_COINSELECTION_H
+
+#include <QVector>
+#include "../wallet/wallet.h"
+
+namespace util {
+
+// Default time limit for the outputs search. Selection is done from UI thread.
+const int64_t COIN_SELECTION_TIME_BUDGET_MS = 50;
+
+struct CoinSelectionResult {
+    bool    ok = false;       // false - not enough funds
+    bool    optimal = false;  // true - search was completed in time, the result is the best possible
+    QVector<int> selected;    // Indexes of selected outputs
+    int64_t total = 0;        // Value of selected outputs
+    double  weightedValue = 0.0; // Minimization target, sum of weight*value for selected outputs
+    int64_t nodes = 0;        // Search nodes visited, for benchmarking
+};
+
+// Select outputs with total value >= nanoCoins and minimal weighted value (see WalletOutput::getWeightedValue).
+// Branch and bound over outputs sorted by value. If time budget is over, the best found solution is returned.
+CoinSelectionResult selectCoins( int64_t nanoCoins, const QVector<wallet::WalletOutput> & outputs,
+                                 int64_t timeBudgetMs = COIN_SELECTION_TIME_BUDGET_MS );
+
+}
+
+#endif //MWC_QT_WALLET_COINSELECTION_H
@@ -0,0 +1,139 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "transactionsexport.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+
+namespace util {
+
+// Single account can have a long history, progress is reported inside the account as well
+const int PROGRESS_RECORDS_STEP = 5000;
+
+TransactionsExportWriter::TransactionsExportWriter( QString _fileName, EXPORT_FORMAT _format, bool _withAccount ) :
+    fileName(_fileName), format(_format), withAccount(_withAccount), cancelled(0)
+{}
+
+TransactionsExportWriter::~TransactionsExportWriter() {
+    delete file;
+}
+
+void TransactionsExportWriter::cancel(QString reason) {
+    cancelled = 1;
+    QMetaObject::invokeMethod( this, "onFinish", Qt::QueuedConnection,
+                               Q_ARG(bool, false), Q_ARG(QString, reason) );
+}
+
+void TransactionsExportWriter::onStart() {
+    if (finished)
+        return;
+
+    Q_ASSERT(file == nullptr);
+    file = new QFile(fileName);
+    if (!file->open(QFile::WriteOnly | QFile::Truncate)) {
+        onFinish(false, "Export unable to write to file: " + fileName);
+        return;
+    }
+
+    if (format == EXPORT_FORMAT::CSV) {
+        write( (withAccount ? "Account," : "") + wallet::WalletTransaction::getCSVHeaders() );
+    }
+}
+
+void TransactionsExportWriter::onTransactions( QString account, int accountIdx, int accountsNum, QVector<wallet::WalletTransaction> transactions ) {
+    if (finished || file == nullptr)
+        return;
+
+    // Account prefix is the same for all records, build it once
+    QString prefix;
+    if (withAccount) {
+        if (format == EXPORT_FORMAT::CSV) {
+            prefix = "\"" + QString(account).replace("\"", "\"\"") + "\",";
+        }
+        else {
+            QJsonObject obj;
+            obj.insert("account", account);
+            prefix = QJsonDocument(obj).toJson(QJsonDocument::JsonFormat::Compact);
+            prefix.chop(1); // '}'
+            prefix += ",";
+        }
+    }
+
+    int counter = 0;
+    for (const wallet::WalletTransaction & tx : transactions) {
+        if (cancelled)
+            return; // onFinish is already in the queue
+
+        QString line;
+        if (format == EXPORT_FORMAT::CSV) {
+            line = prefix + tx.toStringCSV();
+        }
+        else {
+            line = tx.toJson();
+            if (withAccount)
+                line = prefix + line.mid(1); // skip '{'
+        }
+
+        if (!write(line))
+            return;
+
+        records++;
+        if ( ++counter % PROGRESS_RECORDS_STEP == 0 )
+            emit sgnProgress( accountIdx, accountsNum, records );
+    }
+
+    emit sgnProgress( accountIdx+1, accountsNum, records );
+}
+
+void TransactionsExportWriter::onEnd() {
+    if (finished || file == nullptr || cancelled)
+        return;
+
+    file->flush();
+    if (file->error() != QFile::NoError) {
+        onFinish(false, "Export unable to write to file: " + fileName + ", " + file->errorString());
+        return;
+    }
+
+    onFinish(true, "");
+}
+
+void TransactionsExportWriter::onFinish( bool success, QString errorMessage ) {
+    if (finished)
+        return;
+    finished = true;
+
+    if (file != nullptr) {
+        file->close();
+        // Partial export is useless, removing it
+        if (!success)
+            file->remove();
+    }
+
+    emit sgnFinished(success, !success && cancelled, errorMessage, records);
+}
+
+bool TransactionsExportWriter::write( const QString & line ) {
+    QByteArray data = line.toUtf8();
+    data.append('\n');
+    if ( file->write(data) != data.size() ) {
+        onFinish(false, "Export unable to write to file: " + fileName + ", " + file->errorString());
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,72 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_TRANSACTIONSEXPORT_H
+#define MWC_QT_WALLET_TRANSACTIONSEXPORT_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include "../wallet/wallet.h"
+
+class QFile;
+
+namespace util {
+
+enum class EXPORT_FORMAT {CSV = 0, JSON_LINES = 1};
+
+// Transactions export writer. Expected to live at the worker thread. Transactions are formatted and
+// written as they come, nothing is accumulated, so memory usage doesn't depend on the history size.
+class TransactionsExportWriter : public QObject {
+    Q_OBJECT
+public:
+    // withAccount - add account name to every record, needed if several accounts are exported
+    TransactionsExportWriter( QString fileName, EXPORT_FORMAT format, bool withAccount );
+    virtual ~TransactionsExportWriter() override;
+
+    // Can be called from any thread. Writing is stopped at the next record, partial file is removed.
+    // reason - message for the user, empty if user cancelled the export.
+    void cancel(QString reason = "");
+
+public slots:
+    // Create the file and write the header
+    void onStart();
+    // Next account transactions. accountIdx is in range [0..accountsNum)
+    void onTransactions( QString account, int accountIdx, int accountsNum, QVector<wallet::WalletTransaction> transactions );
+    // All data is delivered
+    void onEnd();
+    // Writer stops only once, the rest of calls are ignored.
+    void onFinish( bool success, QString errorMessage );
+
+signals:
+    void sgnProgress( int accountsDone, int accountsNum, qint64 records );
+    // Emitted once. cancelled - export was stopped by cancel(), it is not an error. Message is the cancel reason
+    void sgnFinished( bool success, bool cancelled, QString message, qint64 records );
+
+private:
+    bool write( const QString & line );
+
+private:
+    const QString       fileName;
+    const EXPORT_FORMAT format;
+    const bool          withAccount;
+
+    QFile *    file = nullptr;
+    QAtomicInt cancelled;
+    bool       finished = false;
+    qint64     records = 0;
+};
+
+}
+
+#endif //MWC_QT_WALLET_TRANSACTIONSEXPORT_H
@@ -18,16 +18,19 @@
 #include "../core/global.h"
 #include "../core/WndManager.h"
 #include "../util/stringutils.h"
+#include "../util/coinselection.h"
+#include "../wallet/spendableoutputs.h"
 #include <QVector>
+#include <QMap>
 #include <climits>
-#include <QSet>
+#include <tuple>
 
 namespace util {
 
 // forward declarations
 static
-uint64_t getTxnFeeFromSpendableOutputs(int64_t amount, const QMultiMap<int64_t, wallet::WalletOutput> spendableOutputs,
-                                       uint64_t changeOutputs, uint64_t totalNanoCoins, QStringList& txnOutputList);
+uint64_t getTxnFeeFromSpendableOutputs(int64_t amount, const wallet::SpendableOutputs & spendableOutputs,
+                                       uint64_t changeOutputs, QStringList& txnOutputList, bool useCache);
 
 static QString generateMessageHtmlOutputsToSpend( const QVector<core::HodlOutputInfo> & outputs ) {
     /*
@@ -86,153 +89,14 @@ static QString generateMessageHtmlOutputsToSpend( const QVector<core::HodlOutput
     return result;
 }
 
-static int calcSubstituteIndex( QVector<wallet::WalletOutput> & resultBucket, const wallet::WalletOutput & testOutput, int64_t change ) {
-    double bestWeightedGain = 0.0;
-    int bestIndex = -1;
-
-    const double testWeightedValue = testOutput.getWeightedValue();
-
-    for (int k=0;k<resultBucket.size();k++) {
-        const auto & out = resultBucket[k];
-        if (out.valueNano - testOutput.valueNano > change)
-            continue;
-
-        double weightedGain = out.getWeightedValue() - testWeightedValue;
-        if (weightedGain>bestWeightedGain) {
-            bestWeightedGain = weightedGain;
-            bestIndex = k;
-        }
-    }
-
-    return bestIndex;
-}
-
-// Return resulting bucket weighted amount. Reason: we don't case about change, minimization target is weighted amount.
-static double optimizeBucket( QVector<wallet::WalletOutput> & resultBucket, const QVector<wallet::WalletOutput> & inputOutputs, int64_t nanoCoins ) {
-
-    QSet<QString> bucketCommits;
-    int64_t change = -nanoCoins;
-    for (const auto & out: resultBucket) {
-        bucketCommits += out.outputCommitment;
-        change += out.valueNano;
-    }
-    Q_ASSERT(change>=0); // Not enough funds?
-
-    bool foundBetterSolution = true;
-    while (foundBetterSolution) {
-        foundBetterSolution = false;
-        // doing single scan
-        for (wallet::WalletOutput out: inputOutputs) {
-            if ( bucketCommits.contains(out.outputCommitment) )
-                continue;
-
-            // Check if can substitute
-            int idx = calcSubstituteIndex( resultBucket, out, change );
-            while (idx>=0) {
-                wallet::WalletOutput delOutput = resultBucket[idx];
-                resultBucket[idx] = out;
-                Q_ASSERT( out.getWeightedValue() < delOutput.getWeightedValue() );
-                change -= delOutput.valueNano;
-                change += out.valueNano;
-                Q_ASSERT(change>=0);
-
-                bucketCommits -= delOutput.outputCommitment;
-                bucketCommits += out.outputCommitment;
-
-                foundBetterSolution = true;
-
-                out = delOutput;
-                idx = calcSubstituteIndex( resultBucket, out, change );
-            }
-        }
-    }
-
-    double resultWeightedSum = 0.0;
-    for (const auto & out: resultBucket)
-        resultWeightedSum += out.getWeightedValue();
-
-    return resultWeightedSum;
-}
-
-
-// nanoCoins expected to include the fees. Here we are calculating the outputs that will produce minimal change
+// nanoCoins expected to include the fees. Here we are calculating the outputs that will produce minimal weighted amount
 bool calcOutputsToSpend( int64_t nanoCoins, const QVector<wallet::WalletOutput> & inputOutputs, QStringList & resultOutputs ) {
-    // Try 1,2,3 and 4 outputs to spend (sorry, different workflows)
-    // Than - first smallest commits
-
-    // Sorting in INC order
-    QVector<wallet::WalletOutput> outputs = inputOutputs;
-    std::sort(outputs.begin(), outputs.end(), [](const wallet::WalletOutput &o1, const wallet::WalletOutput &o2) {return o2.valueNano < o1.valueNano;});
-
-
-    // Let's try to minimize the weighted cost for the outputs.
-    // 1 Select few sets of outputs on the result
-    // 2 Trying to minimize the weight by swapping the outputs from the bucket.
-    // 3 Increas number of ouput by step (1 will not work and our tests show that for 3 outputs. ).
-    // Repeat #2
-    // If new result better or the same, go to #3
-    // Done, prev result is an answer
-
-    // Calculating min number of outputs.
-    QVector<int> outputsNumber;
-
-    // Min Number of outputs.
-    {
-        int64_t change = nanoCoins; // Expected to be negative
-        int minOutputsNumber = 0;
-        for ( const auto & out : outputs ) {
-            if (change <= 0)
-                break;
-            change -= out.valueNano;
-            minOutputsNumber++;
-        }
-        if(change>0)
-            return false; // not enough funds
-
-        change = nanoCoins; // Expected to be negative
-        int maxOutputsNumber = 0;
-        for ( auto o = outputs.rbegin(); o!=outputs.rend(); o++ ) {
-            if (change <= 0)
-                break;
-            change -= o->valueNano;
-            maxOutputsNumber++;
-        }
-        Q_ASSERT(change<=0);
+    CoinSelectionResult selection = selectCoins( nanoCoins, inputOutputs );
+    if (!selection.ok)
+        return false; // not enough funds
 
-        Q_ASSERT(minOutputsNumber<=maxOutputsNumber);
-
-        int n=minOutputsNumber;
-        for (; n<std::min(maxOutputsNumber,5); n++)
-            outputsNumber.push_back(n);
-
-        int step = std::max(1,(maxOutputsNumber-minOutputsNumber)/10);
-        for (; n<maxOutputsNumber; n+=step)
-            outputsNumber.push_back(n);
-
-        outputsNumber.push_back(maxOutputsNumber);
-    }
-    Q_ASSERT(!outputsNumber.isEmpty());
-
-    QVector<wallet::WalletOutput> resultBucket;
-    double resultWeightAmount = 100000000.0;
-
-    for ( int outN : outputsNumber ) {
-        QVector<wallet::WalletOutput> bucket;
-        for ( int t=0;t<outN; t++ ) {
-            bucket.push_back(outputs[t]);
-        }
-
-        double weightedAmount = optimizeBucket( bucket, outputs, nanoCoins );
-        if (resultBucket.isEmpty() || weightedAmount < resultWeightAmount) {
-            resultBucket = bucket;
-            resultWeightAmount = weightedAmount;
-        }
-    }
-
-    Q_ASSERT(!resultBucket.isEmpty());
-
-    for (const auto & o : resultBucket) {
-        resultOutputs += o.outputCommitment;
+    for (int idx : selection.selected) {
+        resultOutputs += inputOutputs[idx].outputCommitment;
     }
     return true;
 }
@@ -257,32 +121,18 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
     if ( !hodlStatus->hasAnyOutputsInHODL() && !appContext->isLockOutputEnabled() )
         return true; // let mwc713 wallet handle it
 
-    QVector<wallet::WalletOutput>  outputs = wallet->getwalletOutputs().value(accountName);
+    // Unspent, mature, not locked outputs sorted by value
+    const wallet::SpendableOutputs & spendable = wallet->getSpendableOutputs(accountName);
 
     QVector<QPair<wallet::WalletOutput, core::HodlOutputInfo>> hodlOuts;
-    //QVector<wallet::WalletOutput> freeOuts;
-    QMultiMap<int64_t, wallet::WalletOutput> freeOuts;
+    QVector<wallet::WalletOutput> freeOuts;
 
     int64_t freeNanoCoins = 0;
-    int64_t totalNanoCoins = 0;
 
     QStringList allOutputs;
 
-    for ( wallet::WalletOutput o : outputs) {
-        // Keep unspent only
-        if ( o.status != "Unspent" ) // Interesting only in Unspent outputs
-            continue;
-        // Skip mined that can't spend
-        if (o.coinbase && o.numOfConfirms.toLong()<=1440 )
-            continue;
-        if (!o.coinbase && o.numOfConfirms.toInt() < appContext->getSendCoinsParams().inputConfirmationNumber)
-            continue;
-        // Skip locked
-        if (appContext->isLockedOutputs(o.outputCommitment))
-            continue;
-
+    for ( wallet::WalletOutput o : spendable.getOutputs()) {
         allOutputs.push_back(o.outputCommitment);
-        totalNanoCoins += o.valueNano;
 
         core::HodlOutputInfo ho = hodlStatus->getHodlOutput("", o.outputCommitment);
 
@@ -292,7 +142,7 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
         }
         else {
             o.weight = 0.01;
-            freeOuts.insert(o.valueNano, o);  // inserts by value
+            freeOuts.push_back(o);  // keeps the value order
             freeNanoCoins += o.valueNano;
         }
     }
@@ -301,18 +151,19 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
         // nothing on this account is in HODL
         if (appContext->isLockOutputEnabled()) {
             resultOutputs = allOutputs;
-            *txnFee = getTxnFeeFromSpendableOutputs(nanoCoins, freeOuts, outputsNumber, totalNanoCoins, resultOutputs);
+            *txnFee = getTxnFeeFromSpendableOutputs(nanoCoins, spendable, outputsNumber, resultOutputs, true);
         }
         return true;
     }
 
+    wallet::SpendableOutputs freeSpendable;
+    freeSpendable.setOutputs(freeOuts);
+
     if (nanoCoins<0) {
         // handle spending all spendable outputs
         QVector<core::HodlOutputInfo> spentOuts;
         for (const auto & ho : hodlOuts ) {
             spentOuts.push_back(ho.second);
-            // combine the HODL outputs by value with the free outputs
-            freeOuts.insert(ho.first.valueNano, ho.first);
         }
 
         // Ask user if he wants to spend all and continue...
@@ -324,7 +175,8 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
                 true, false, 1.4) ) {
             resultOutputs = allOutputs;
             int changeOutputs = 0;  // we don't expect any change since we are spending all of our outputs
-            *txnFee = getTxnFeeFromSpendableOutputs(nanoCoins, freeOuts, changeOutputs, totalNanoCoins, resultOutputs);
+            // HODL and free outputs together are all spendable outputs
+            *txnFee = getTxnFeeFromSpendableOutputs(nanoCoins, spendable, changeOutputs, resultOutputs, true);
             return true;
         }
         else {
@@ -343,7 +195,8 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
 
     // Calculate what outputs need to be selected...
     if (freeNanoCoins >= nanoCoins + maxFee) {
-        *txnFee = getTxnFeeFromSpendableOutputs(nanoCoins, freeOuts, outputsNumber, freeNanoCoins, resultOutputs);
+        // freeSpendable is built for this call only, its revision will never be asked again
+        *txnFee = getTxnFeeFromSpendableOutputs(nanoCoins, freeSpendable, outputsNumber, resultOutputs, false);
         return true;
     }
 
@@ -391,7 +244,7 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
 
     // User approve the spending, preparing the list of outputs...
     resultOutputs = hodlResultOutputs;
-    for ( const auto & o : freeOuts.values() )
+    for ( const auto & o : freeOuts )
         resultOutputs.push_back( o.outputCommitment );
 
     // calculate transaction fee
@@ -402,79 +255,25 @@ bool getOutputsToSend( const QString & accountName, int outputsNumber, int64_t n
 }
 
 //
-// Populates a multimap with outputs available for spending using the output's value as the key.
-//
-static void
-findSpendableOutputs(const QString& accountName, const wallet::Wallet* wallet, core::AppContext* appContext,
-                     QMultiMap<int64_t, wallet::WalletOutput>& spendableOutputs) {
-
-    QVector<wallet::WalletOutput>  outputs = wallet->getwalletOutputs().value(accountName);
-    for ( wallet::WalletOutput o : outputs) {
-        if ( o.status != "Unspent" ) // Interested only in Unspent outputs
-            continue;
-        // Skip mined that can't spend
-        if (o.coinbase && o.numOfConfirms.toLong()<=mwc::COIN_BASE_CONFIRM_NUMBER )
-            continue;
-        if (!o.coinbase && o.numOfConfirms.toInt() < appContext->getSendCoinsParams().inputConfirmationNumber)
-            continue;
-        // ensure outputs locked by Qt Wallet are not used
-        if (appContext->isLockOutputEnabled() && appContext->isLockedOutputs(o.outputCommitment))
-            continue;
-        spendableOutputs.insert(o.valueNano, o);
-    }
-}
-
-static int64_t
-getTotalCoins(const QVector<wallet::WalletOutput> outputs) {
-    int64_t total = 0;
-    for ( wallet::WalletOutput o : outputs) {
-        total += o.valueNano;
-    }
-    return total;
-}
-
-static int64_t
-getTotalCoinsFromMap(const QMultiMap<int64_t, wallet::WalletOutput> outputs) {
-    int64_t total = 0;
-    for ( int64_t valueNano : outputs.keys()) {
-        total += valueNano;
-    }
-    return total;
-}
-
-//
-// Returns an array of the outputs to include, as inputs, in the transaction.
+// Returns the number of the smallest outputs to include, as inputs, in the transaction.
+// Outputs are sorted by value, so the search over the prefix sums is O(log n).
 //
 // Parameters:
-//    amountNano - The amount in nano coins to spend. May or may not include the txn fee.
-//    spendableOutputs - Vector of spendable outputs (sorted in the order to be used)
+//    amountNano - The amount in nano coins to spend. May or may not include the txn fee. Negative - all coins.
+//    spendableOutputs - spendable outputs (sorted in the order to be used)
 //
-static void
-retrieveTransactionInputs(int64_t amountNano, QMultiMap<int64_t, wallet::WalletOutput> spendableOutputs,
-                          uint64_t* totalNanoCoins, QVector<wallet::WalletOutput>& inputs)
+static int
+retrieveTransactionInputs(int64_t amountNano, const wallet::SpendableOutputs & spendableOutputs)
 {
-    inputs.clear();
-    if (*totalNanoCoins == 0) {
-        *totalNanoCoins = getTotalCoinsFromMap(spendableOutputs);
-    }
-
     if (amountNano < 0) {
         // send all coins
-        inputs = spendableOutputs.values().toVector();
-    }
-    else {
-        uint64_t amount = amountNano;
-        if (amount < *totalNanoCoins) {
-            int64_t amountToSpend = amountNano;
-            int64_t selectedAmount = 0L;
-            for (wallet::WalletOutput o : spendableOutputs.values()) {
-                if (selectedAmount < amountToSpend) {
-                    inputs.push_back(o);
-                    selectedAmount += o.valueNano;
-                }
-            }
-        }
+        return spendableOutputs.size();
     }
+
+    if (amountNano >= spendableOutputs.getTotal())
+        return 0;
+
+    return spendableOutputs.countToCover(amountNano);
 }
 
 //
@@ -496,25 +295,22 @@ uint64_t calcTxnFee(uint64_t numInputs, uint64_t numOutputs, uint64_t numKernels
 
 //
 // Calculates the transaction fee from the array of spendable outputs.
-// If an error occurs, displays a message on the parent window and returns -1.
+// Result fee is 0 if there are not enough coins.
 //
 static
-uint64_t getTxnFeeFromSpendableOutputs(int64_t amount, const QMultiMap<int64_t, wallet::WalletOutput> spendableOutputs,
-                                       uint64_t changeOutputs, uint64_t totalNanoCoins, QStringList& txnOutputList) {
+TxnFeeEstimate calcTxnFeeEstimate(int64_t amount, const wallet::SpendableOutputs & spendableOutputs, uint64_t changeOutputs) {
+
+    TxnFeeEstimate result;
 
-    uint64_t totalCoins = totalNanoCoins;
+    uint64_t totalCoins = spendableOutputs.getTotal();
 
     uint64_t numKernels = 1;     // always 1 for now
     uint64_t resultOutputs = 1;  // we always have at least 1 result output for the receiver's output
 
-    // retrieval of the transaction inputs from the Map will result
-    // in the inputs being sorted in ascending order by value
-    QVector<wallet::WalletOutput> txnInputs;
-    retrieveTransactionInputs(amount, spendableOutputs, &totalCoins, txnInputs);
-
-    uint64_t numInputs = txnInputs.size();
+    // transaction inputs are the smallest outputs, spendableOutputs are sorted in ascending order by value
+    int numInputs = retrieveTransactionInputs(amount, spendableOutputs);
     if (numInputs == 0) {
-        return 0;
+        return result;
     }
 
     uint64_t txnFee = calcTxnFee(numInputs, resultOutputs, numKernels);
@@ -536,21 +332,17 @@ uint64_t getTxnFeeFromSpendableOutputs(int64_t amount, const QMultiMap<int64_t,
         txnFee = calcTxnFee(numInputs, numOutputs, numKernels);
         amountWithFee = amount + txnFee;
 
-        uint64_t transactionTotal = 0;
-        for (wallet::WalletOutput o : txnInputs) {
-            transactionTotal += o.valueNano;
-        }
+        uint64_t transactionTotal = spendableOutputs.getPrefixSum(numInputs);
 
         // check again to ensure we have enough outputs for the amount including the fee
         if (transactionTotal < amountWithFee) {
-            retrieveTransactionInputs(amountWithFee, spendableOutputs, &totalCoins, txnInputs);
-            numInputs = txnInputs.size();
+            numInputs = retrieveTransactionInputs(amountWithFee, spendableOutputs);
             // only recalculate txnFee if we had inputs
             // otherwise pass out the latest txnFee so the caller can display
             // it in their error message
             if (numInputs > 0)
             {
-                totalCoins = getTotalCoins(txnInputs);
+                totalCoins = spendableOutputs.getPrefixSum(numInputs);
                 txnFee = calcTxnFee(numInputs, numOutputs, numKernels);
                 amountWithFee = amount + txnFee;
             }
@@ -559,16 +351,62 @@ uint64_t getTxnFeeFromSpendableOutputs(int64_t amount, const QMultiMap<int64_t,
             txnFee = 0;
         }
     }
+
+    result.numInputs = numInputs;
+    result.fee = txnFee;
+    result.inputsTotal = spendableOutputs.getPrefixSum(numInputs);
+    return result;
+}
+
+// Send dialogs are asking for the same amounts many times. Key: outputs revision, amount, change outputs.
+// Only the outputs from the wallet spendable index are cached, one-shot sets have a new revision every time.
+static QMap< std::tuple<int64_t, int64_t, uint64_t>, TxnFeeEstimate > feeEstimateCache;
+// Revisions are growing, the old ones are useless. Keeping cache small
+#define FEE_ESTIMATE_CACHE_SIZE 256
+
+static
+TxnFeeEstimate getTxnFeeEstimate(int64_t amount, const wallet::SpendableOutputs & spendableOutputs, uint64_t changeOutputs, bool useCache) {
+    if (!useCache)
+        return calcTxnFeeEstimate(amount, spendableOutputs, changeOutputs);
+
+    const auto key = std::make_tuple( spendableOutputs.getRevision(), amount, changeOutputs );
+    auto cached = feeEstimateCache.constFind(key);
+    if (cached != feeEstimateCache.constEnd())
+        return cached.value();
+
+    if (feeEstimateCache.size() >= FEE_ESTIMATE_CACHE_SIZE)
+        feeEstimateCache.clear();
+
+    TxnFeeEstimate result = calcTxnFeeEstimate(amount, spendableOutputs, changeOutputs);
+    feeEstimateCache.insert(key, result);
+    return result;
+}
+
+//
+// Calculates the transaction fee from the array of spendable outputs.
+// If we were given an empty txnOutputList, populate it with the inputs.
+//
+static
+uint64_t getTxnFeeFromSpendableOutputs(int64_t amount, const wallet::SpendableOutputs & spendableOutputs,
+                                       uint64_t changeOutputs, QStringList& txnOutputList, bool useCache) {
+
+    TxnFeeEstimate estimate = getTxnFeeEstimate(amount, spendableOutputs, changeOutputs, useCache);
+
     // if we were given an empty txnOutputList, populate it so that mwc713
     // will use the same outputs as we did when calculating the txn fee
     // and large number of outputs will not need to be scanned again
-    if (txnFee != 0 && txnOutputList.size() == 0) {
-        for (wallet::WalletOutput o : txnInputs) {
-            txnOutputList.push_back(o.outputCommitment);
+    if (estimate.fee != 0 && txnOutputList.size() == 0) {
+        const QVector<wallet::WalletOutput> & outputs = spendableOutputs.getOutputs();
+        for (int i=0; i<estimate.numInputs; i++) {
+            txnOutputList.push_back(outputs[i].outputCommitment);
         }
     }
 
-    return txnFee;
+    return estimate.fee;
+}
+
+TxnFeeEstimate estimateTxnFee(const QString& accountName, int64_t amount, wallet::Wallet* wallet, uint64_t changeOutputs) {
+    return getTxnFeeEstimate(amount, wallet->getSpendableOutputs(accountName), changeOutputs, true);
 }
 
 //
@@ -595,12 +433,12 @@ uint64_t getTxnFee(const QString& accountName, int64_t amount, wallet::Wallet* w
     if (txnOutputList.size() > 0)
         return 0;
 
+    Q_UNUSED(appContext)
     uint64_t txnFee = 0;
-    QMultiMap<int64_t, wallet::WalletOutput> spendableOutputs;
-    findSpendableOutputs(accountName, wallet, appContext, spendableOutputs);
+    const wallet::SpendableOutputs & spendableOutputs = wallet->getSpendableOutputs(accountName);
 
     if (spendableOutputs.size() > 0) {
-        txnFee = getTxnFeeFromSpendableOutputs(amount, spendableOutputs, changeOutputs, 0, txnOutputList);
+        txnFee = getTxnFeeFromSpendableOutputs(amount, spendableOutputs, changeOutputs, txnOutputList, true);
     }
 
     return txnFee;
@@ -618,11 +456,11 @@ QString txnFeeToString(uint64_t nanoTxnFee) {
 QString getAllSpendableAmount(const QString& accountName, wallet::Wallet* wallet, core::AppContext* appContext) {
     QString allSpendableAmount = "All";
 
-    QMultiMap<int64_t, wallet::WalletOutput> spendableOutputs;
-    findSpendableOutputs(accountName, wallet, appContext, spendableOutputs);
+    Q_UNUSED(appContext)
+    const wallet::SpendableOutputs & spendableOutputs = wallet->getSpendableOutputs(accountName);
     int64_t numSpendableOutputs = spendableOutputs.size();
     if (numSpendableOutputs > 0) {
-        int64_t totalSpendableCoins = getTotalCoinsFromMap(spendableOutputs);
+        int64_t totalSpendableCoins = spendableOutputs.getTotal();
         // we don't expect any change since we are spending all coin
         uint64_t txnFee = calcTxnFee(numSpendableOutputs, 1, 1);
         int64_t allAmount = totalSpendableCoins - txnFee;
@@ -57,6 +57,17 @@ namespace util {
                        core::AppContext* appContext, uint64_t changeOutputs,
                        QStringList& txnOutputList);
 
+    struct TxnFeeEstimate {
+        int      numInputs = 0;   // Number of the smallest spendable outputs that will be used as inputs
+        uint64_t fee = 0;         // 0 if fee could not be calculated (not enough coins)
+        int64_t  inputsTotal = 0; // Value of the inputs
+    };
+
+    // Estimate the transaction fee for the amount (negative - ALL) with the smallest first inputs selection, same as mwc713 does.
+    // It is O(log n) and results are cached until account spendable outputs are changed, so it is fine to call it on every key press.
+    // HODL outputs and locked outputs selection is not accounted, see getOutputsToSend.
+    TxnFeeEstimate estimateTxnFee(const QString& accountName, int64_t amount, wallet::Wallet* wallet, uint64_t changeOutputs);
+
     //
     // Even though you will find documentation which says the transaction fee is
     // calculated as 4*(num_outputs + num_kernels) - num_inputs that is not what is actually
@@ -14,6 +14,8 @@
 
 #include "MockWallet.h"
 #include "../util/crypto.h"
+#include "spendableoutputs.h"
+#include "transactionsindex.h"
 
 namespace wallet {
 
@@ -176,6 +178,13 @@ const QMap<QString, QVector<wallet::WalletOutput> > &  MockWallet::getwalletOutp
     return emptyOutputs;
 }
 
+static SpendableOutputs emptySpendable;
+
+const SpendableOutputs & MockWallet::getSpendableOutputs(const QString & accountName) {
+    Q_UNUSED(accountName)
+    return emptySpendable;
+}
+
 // Request Wallet balance update. It is a multistep operation
 // Check signal: onWalletBalanceUpdated
 //          onWalletBalanceProgress
@@ -260,7 +269,8 @@ bool MockWallet::setWalletConfig(const WalletConfig &config, bool canStartNode)
 // Status of the node
 // return true if task was scheduled
 // Check Signal: onNodeStatus( bool online, QString errMsg, int height, int64_t totalDifficulty, int connections )
-bool MockWallet::getNodeStatus() {
+bool MockWallet::getNodeStatus(bool useCached) {
+    Q_UNUSED(useCached)
     emit onNodeStatus( true, "", 12345, 12345, 1234567, 5 );
     return true;
 }
@@ -384,12 +394,12 @@ void MockWallet::getOutputs(QString account, bool show_spent, bool enforceSync)
 
     QVector<WalletOutput> outputs;
     outputs.push_back(WalletOutput::create("01234327643847563487654386",
-            "123",
-            "1234",
-            "1234",
-            "Sent",
+            123,
+            1234,
+            1234,
+            WalletOutput::STATUS::SPENT,
             false,
-            "4",
+            4,
             1000000000,
             2));
     emit onOutputs( account, show_spent, 12345, outputs);
@@ -474,6 +484,44 @@ void MockWallet::getAllTransactions() {
     emit onAllTransactions( {tx} );
 }
 
+// Read transactions account by account. account - account to read, empty for all accounts.
+// Check Signals: onAllTransactionsChunk, onAllTransactionsStreamEnd
+int MockWallet::streamAllTransactions(QString account) {
+    WalletTransaction tx;
+    tx.setData(2,
+               WalletTransaction::TRANSACTION_TYPE::SEND,
+               "4",
+               "address",
+               "02-02-2020 10:00",
+               true,
+               1234,
+               1234,
+               "02-02-2020 10:00",
+               1,
+               2,
+               1000000000,
+               1000000000,
+               10000000,
+               1000000000,
+               false,
+               "3746538765238745643");
+
+    const int streamId = 1;
+    emit onAllTransactionsChunk( streamId, account.isEmpty() ? "default" : account, 0, 1, {tx} );
+    emit onAllTransactionsStreamEnd( streamId, true );
+    return streamId;
+}
+
+QVector<IndexedTransaction> MockWallet::searchTransactions(const TransactionsQuery & query, int limit) {
+    Q_UNUSED(query)
+    Q_UNUSED(limit)
+    return QVector<IndexedTransaction>();
+}
+
+QVector<QString> MockWallet::getNotIndexedAccounts() {
+    return QVector<QString>();
+}
+
 // Get root public key with signed message. Message is optional, can be empty
 // Check Signal: onRootPublicKey( QString rootPubKey, QString message, QString signature )
 void MockWallet::getRootPublicKey(QString message2sign) {
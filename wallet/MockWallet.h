@@ -150,6 +150,8 @@ public:
     // Get outputs that was collected for this wallet. Outputs should be ready with balances
     virtual const QMap<QString, QVector<wallet::WalletOutput> > & getwalletOutputs() const override;
 
+    virtual const SpendableOutputs & getSpendableOutputs(const QString & accountName) override;
+
     virtual QString getCurrentAccountName()  override {return currentAccount;}
 
     // Request sync (update_wallet_state) for the
@@ -160,6 +162,9 @@ public:
     //          onWalletBalanceProgress
     virtual void updateWalletBalance(bool enforceSync, bool showSyncProgress, bool skipSync=false) override;
 
+    // Request Wallet balance update only if something might change since the last update
+    virtual void updateWalletBalanceIfChanged(bool enforceSync) override {updateWalletBalance(enforceSync, false);}
+
 
     // Create another account, note no delete exist for accounts
     // Check Signal:  onAccountCreated
@@ -195,7 +200,7 @@ public:
     // Status of the node
     // return true if task was scheduled
     // Check Signal: onNodeSatatus( bool online, QString errMsg, int height, int64_t totalDifficulty, int connections )
-    virtual bool getNodeStatus() override;
+    virtual bool getNodeStatus(bool useCached) override;
 
     // -------------- Transactions
 
@@ -266,6 +271,13 @@ public:
     // Check Signal: onAllTransactions( QVector<WalletTransaction> Transactions)
     virtual void getAllTransactions() override;
 
+    // Read transactions account by account. account - account to read, empty for all accounts.
+    // Check Signals: onAllTransactionsChunk, onAllTransactionsStreamEnd
+    virtual int streamAllTransactions(QString account) override;
+
+    virtual QVector<IndexedTransaction> searchTransactions(const TransactionsQuery & query, int limit) override;
+    virtual QVector<QString> getNotIndexedAccounts() override;
+
     // Get root public key with signed message. Message is optional, can be empty
     // Check Signal: onRootPublicKey( QString rootPubKey, QString message, QString signature )
     virtual void getRootPublicKey( QString message2sign ) override;
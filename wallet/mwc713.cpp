@@ -20,6 +20,8 @@
 #include <QTimer>
 #include "../tries/mwc713inputparser.h"
 #include "mwc713events.h"
+#include "mwc713reader.h"
+#include "mwc713metrics.h"
 #include <QApplication>
 #include <core/Notification.h>
 #include "tasks/TaskStarting.h"
@@ -43,10 +45,27 @@
 #include "../node/MwcNode.h"
 #include <QCoreApplication>
 #include "../util/crypto.h"
+#include "../util/stringutils.h"
 #include "../core/WndManager.h"
 
 namespace wallet {
 
+// Order accounts for the sweep with a switch to every account. First account is already active at mwc713,
+// last one is where we need to return. Both switches become not needed.
+static QVector<QString> orderAccountsForSweep(const QVector<QString> & accounts, const QString & firstAccount, const QString & lastAccount) {
+    QVector<QString> res;
+    res.reserve(accounts.size());
+    if (accounts.contains(firstAccount))
+        res.push_back(firstAccount);
+    for (const QString & acc : accounts) {
+        if (acc != firstAccount && acc != lastAccount)
+            res.push_back(acc);
+    }
+    if (lastAccount != firstAccount && accounts.contains(lastAccount))
+        res.push_back(lastAccount);
+    return res;
+}
+
 // Base class for wallet state, Non managed object. Consumer suppose to delete it
 class Mwc713State {
     Mwc713State();
@@ -189,7 +208,6 @@ void MWC713::resetData(STARTED_MODE _startedMode ) {
     httpInfo = "";
     hasHttpTls = false;
     walletPasswordHash = "";
-    outputsLines.clear();
     currentAccount = "default";
     recieveAccount = "default";
     currentConfig = WalletConfig();
@@ -238,7 +256,7 @@ void MWC713::start()  {
 
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(outputReader == nullptr);
 
     qDebug() << "Starting MWC713 at " << mwc713Path << " for config " << mwc713configPath;
 
@@ -247,10 +265,12 @@ void MWC713::start()  {
     if (mwc713process==nullptr)
         return;
 
-    inputParser = new tries::Mwc713InputParser();
+    tries::Mwc713InputParser * inputParser = new tries::Mwc713InputParser();
 
     eventCollector = new Mwc713EventManager(this);
     eventCollector->connectWith(inputParser);
+    // Parser is moved to the reader thread, events are still delivered with queued connection
+    outputReader = new Mwc713OutputReader(inputParser);
     // Add first init task
     eventCollector->addTask( new TaskStarting(this), TaskStarting::TIMEOUT );
 
@@ -268,7 +288,7 @@ void MWC713::start()  {
 void MWC713::start2init(QString password) {
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(outputReader == nullptr);
 
     QString path = appContext->getCurrentWalletInstance(false);
     if (!updateWalletConfig(path, false))
@@ -284,10 +304,12 @@ void MWC713::start2init(QString password) {
     if (mwc713process==nullptr)
         return;
 
-    inputParser = new tries::Mwc713InputParser();
+    tries::Mwc713InputParser * inputParser = new tries::Mwc713InputParser();
 
     eventCollector = new Mwc713EventManager(this);
     eventCollector->connectWith(inputParser);
+    // Parser is moved to the reader thread, events are still delivered with queued connection
+    outputReader = new Mwc713OutputReader(inputParser);
 
     // Adding permanent listeners
     // Adding permanent listeners
@@ -309,7 +331,7 @@ void MWC713::start2recover(const QVector<QString> & seed, QString password) {
 
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(outputReader == nullptr);
 
     QString path = appContext->getCurrentWalletInstance(false);
     if (!updateWalletConfig(path, true))
@@ -330,10 +352,12 @@ void MWC713::start2recover(const QVector<QString> & seed, QString password) {
     if (mwc713process==nullptr)
         return;
 
-    inputParser = new tries::Mwc713InputParser();
+    tries::Mwc713InputParser * inputParser = new tries::Mwc713InputParser();
 
     eventCollector = new Mwc713EventManager(this);
     eventCollector->connectWith(inputParser);
+    // Parser is moved to the reader thread, events are still delivered with queued connection
+    outputReader = new Mwc713OutputReader(inputParser);
     // Add first init task
     eventCollector->addTask( new TaskRecoverFull( this), TaskRecoverFull::TIMEOUT );
 
@@ -354,6 +378,9 @@ void MWC713::processStop(bool exitNicely) {
 
     logger::logInfo("MWC713", QString("mwc713 process exiting ") + (exitNicely? "nicely" : "by killing") );
 
+    // Keep learned timeouts for the next run
+    getTimeoutModel().save();
+
     if (mwc713process) {
         // Waitiong for task Q to be empty
         // Note, event processing can change a lot for us, so we shoudl watch for variables
@@ -391,6 +418,11 @@ void MWC713::processStop(bool exitNicely) {
         mwc713process = nullptr;
     }
 
+    // Queued stream tasks are cancelled or died with the process
+    abortTransactionStreams();
+    // Index requests are cancelled as well, they will be scheduled again after login
+    indexingAccounts.clear();
+
     loggedIn = false;
 
     mwc713disconnect();
@@ -400,8 +432,17 @@ void MWC713::processStop(bool exitNicely) {
     mwcAddress = "";
     accountInfoNoLocks.clear();
     walletOutputs.clear();
+    spendableIndex = SpendableOutputsIndex();
+    dataCache.setWalletDataPath("");
+    txIndex.clear();
+    indexingAccounts.clear();
     currentAccount = "default"; // Keep current account by name. It fit better to mwc713 interactions.
     collectedAccountInfo.clear();
+    collectedAccountOrder.clear();
+    lastNodeHeight = balanceRefreshHeight = lastBalanceRefreshTime = 0;
+    lastNodeStatus = NodeStatusCache();
+    balanceChangedAll = true;
+    dirtyAccounts.clear();
 
     emit onListenersStatus(false, false, false);
 
@@ -415,9 +456,9 @@ void MWC713::processStop(bool exitNicely) {
     emit onMwcAddressWithIndex("",1);
     emit onTorAddress("");
 
-    if (inputParser) {
-        inputParser->deleteLater();
-        inputParser = nullptr;
+    if (outputReader) {
+        delete outputReader;
+        outputReader = nullptr;
     }
 
     if (eventCollector) {
@@ -623,6 +664,9 @@ void MWC713::updateWalletBalance(bool enforceSync, bool showSyncProgress, bool s
     // 2 - for every account get info ( see updateAccountList call )
     // 3 - restore back current account
 
+    // Balance refresh is a background job, user actions can go first
+    TaskBatchScope batch(eventCollector, TASK_PRIORITY::BACKGROUND);
+
     if (!hasPassword()) {
         // By some reasons wallet without password can be locked by itself
         eventCollector->addTask( new TaskUnlock(this, ""), TaskUnlock::TIMEOUT );
@@ -632,6 +676,78 @@ void MWC713::updateWalletBalance(bool enforceSync, bool showSyncProgress, bool s
         sync(showSyncProgress, enforceSync);
 
     eventCollector->addTask( task, TaskAccountList::TIMEOUT );
+    resetBalanceChanges();
+}
+
+// Full refresh period, even if we don't see any changes. Just in case if some events was missed.
+static const int64_t BALANCE_FULL_REFRESH_PERIOD = 10*60*1000;
+
+// Request Wallet balance update only for accounts that might change since the last refresh.
+// Account can change if we got a new block and it has non confirmed or locked coins,
+// or because of wallet events (slates, cancellation, listeners restart).
+void MWC713::updateWalletBalanceIfChanged(bool enforceSync) {
+    if ( !isWalletRunningAndLoggedIn() )
+        return; // ignoring request
+
+    if ( balanceChangedAll || accountInfoNoLocks.isEmpty() ||
+            QDateTime::currentMSecsSinceEpoch() - lastBalanceRefreshTime > BALANCE_FULL_REFRESH_PERIOD ) {
+        updateWalletBalance(enforceSync, false);
+        return;
+    }
+
+    bool heightChanged = lastNodeHeight != balanceRefreshHeight;
+
+    QVector<QString> accounts;
+    for (const AccountInfo & acc : accountInfoNoLocks) {
+        // Mined coins are immature, received coins are waiting for confirmations
+        bool pending = acc.awaitingConfirmation>0 || acc.lockedByPrevTransaction>0 || acc.total != acc.currentlySpendable ||
+                acc.accountName == recieveAccount;
+        if ( dirtyAccounts.contains(acc.accountName) || (heightChanged && pending) )
+            accounts.push_back(acc.accountName);
+    }
+
+    if (accounts.isEmpty()) {
+        logger::logInfo("MWC713", "Skipping balance update, no changes since height " + QString::number(balanceRefreshHeight) );
+        balanceRefreshHeight = lastNodeHeight;
+        return;
+    }
+
+    if (accounts.size() == accountInfoNoLocks.size()) {
+        updateWalletBalance(enforceSync, false);
+        return;
+    }
+
+    // Check if already running
+    Mwc713Task * task = new TaskAccountListPartial(this, accounts);
+    TaskAccountList fullTask(this);
+    if ( eventCollector->hasTask(task) || eventCollector->hasTask(&fullTask) ) {
+        delete task;
+        return;
+    }
+
+    logger::logInfo("MWC713", "Partial balance update for accounts: " + QStringList(accounts.toList()).join(", ") );
+
+    TaskBatchScope batch(eventCollector, TASK_PRIORITY::BACKGROUND);
+
+    if (!hasPassword()) {
+        // By some reasons wallet without password can be locked by itself
+        eventCollector->addTask( new TaskUnlock(this, ""), TaskUnlock::TIMEOUT );
+    }
+
+    sync(false, enforceSync);
+
+    eventCollector->addTask( task, -1 );
+
+    balanceRefreshHeight = lastNodeHeight;
+    for (const QString & acc : accounts)
+        dirtyAccounts.remove(acc);
+}
+
+void MWC713::resetBalanceChanges() {
+    balanceRefreshHeight = lastNodeHeight;
+    lastBalanceRefreshTime = QDateTime::currentMSecsSinceEpoch();
+    balanceChangedAll = false;
+    dirtyAccounts.clear();
 }
 
 // Create another account, note no delete exist for accounts
@@ -751,8 +867,17 @@ void MWC713::submitFile( QString fileTx ) {
 // Show outputs for the wallet
 // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> Transactions)
 void MWC713::getOutputs(QString account, bool show_spent, bool enforceSync)  {
+    // Show cached data first, the fresh data will follow if something changed
+    int64_t cachedHeight = -1;
+    QVector<WalletOutput> cachedOutputs;
+    if (dataCache.getOutputs(account, show_spent, cachedHeight, cachedOutputs)) {
+        logger::logEmit( "MWC713", "onOutputs", "account="+account + " from cache" );
+        emit onOutputs( account, show_spent, cachedHeight, cachedOutputs );
+    }
+
     sync(true, enforceSync);
-    // Need to switch account first
+    // Need to switch account first. Requests for the same account are grouped to save the switches.
+    TaskBatchScope batch(eventCollector, TASK_PRIORITY::INTERACTIVE, account);
     eventCollector->addTask( new TaskAccountSwitch(this, account), TaskAccountSwitch::TIMEOUT );
     eventCollector->addTask( new TaskOutputs(this, show_spent), TaskOutputs::TIMEOUT );
     if (account!=currentAccount)
@@ -760,8 +885,17 @@ void MWC713::getOutputs(QString account, bool show_spent, bool enforceSync)  {
 }
 
 void MWC713::getTransactions(QString account, bool enforceSync)  {
+    // Show cached data first, the fresh data will follow if something changed
+    int64_t cachedHeight = -1;
+    QVector<WalletTransaction> cachedTransactions;
+    if (dataCache.getTransactions(account, cachedHeight, cachedTransactions)) {
+        logger::logEmit( "MWC713", "onTransactions", "account="+account + " from cache" );
+        emit onTransactions( account, cachedHeight, cachedTransactions );
+    }
+
     sync(true, enforceSync);
-    // Need to switch account first
+    // Need to switch account first. Requests for the same account are grouped to save the switches.
+    TaskBatchScope batch(eventCollector, TASK_PRIORITY::INTERACTIVE, account);
     eventCollector->addTask( new TaskAccountSwitch(this, account), TaskAccountSwitch::TIMEOUT );
     eventCollector->addTask( new TaskTransactions(this), TaskTransactions::TIMEOUT );
     if (account!=currentAccount)
@@ -771,6 +905,7 @@ void MWC713::getTransactions(QString account, bool enforceSync)  {
 // get Extended info for specific transaction
 // Check Signal: onTransactionById( bool success, QString account, int64_t height, WalletTransaction transaction, QVector<WalletOutput> outputs, QVector<QString> messages )
 void MWC713::getTransactionById(QString account, int64_t txIdx ) {
+    TaskBatchScope batch(eventCollector, TASK_PRIORITY::INTERACTIVE, account);
     eventCollector->addTask( new TaskAccountSwitch(this, account), TaskAccountSwitch::TIMEOUT );
     eventCollector->addTask( new TaskTransactionsById(this, txIdx), TaskTransactions::TIMEOUT );
     if (account != currentAccount)
@@ -782,21 +917,48 @@ void MWC713::getTransactionById(QString account, int64_t txIdx ) {
 // Schedule bunch of requests.
 void MWC713::getAllTransactions() {
     // Requesting transactions for all accounts...
-    Mwc713Task * task = new TaskAllTransactionsEnd(this);
+    Mwc713Task * task = new TaskAllTransactionsEnd(this, 0);
     if ( eventCollector->hasTask(task) ) {
         delete task;
         return;
     }
 
+    QVector<QString> accounts;
+    for (const AccountInfo & acc : accountInfoNoLocks )
+        accounts.push_back(acc.accountName);
+
+    scheduleAllTransactions(accounts, 0, task);
+}
+
+// Read transactions account by account. account - account to read, empty for all accounts.
+// Check Signals: onAllTransactionsChunk, onAllTransactionsStreamEnd
+int MWC713::streamAllTransactions(QString account) {
+    // Every stream request is served, caller is matching the signals by the stream id
+    QVector<QString> accounts;
+    for (const AccountInfo & acc : accountInfoNoLocks ) {
+        if (account.isEmpty() || acc.accountName == account)
+            accounts.push_back(acc.accountName);
+    }
+
+    const int streamId = ++lastStreamId;
+    pendingStreams.push_back(streamId);
+    scheduleAllTransactions(accounts, streamId, new TaskAllTransactionsEnd(this, streamId));
+    return streamId;
+}
+
+void MWC713::scheduleAllTransactions(const QVector<QString> & accounts, int streamId, Mwc713Task * endTask) {
+    TaskBatchScope batch(eventCollector, TASK_PRIORITY::BACKGROUND);
+
     // By first task only checking if it is exist
-    eventCollector->addTask( new TaskAllTransactionsStart(this), -1);
+    eventCollector->addTask( new TaskAllTransactionsStart(this, streamId, accounts.size()), -1);
 
     // I f not exist, push the rest with enforcement...
-    for (const AccountInfo & acc : accountInfoNoLocks ) {
-            eventCollector->addTask(new TaskAccountSwitch(this, acc.accountName), TaskAccountSwitch::TIMEOUT);
+    // Current account goes last, so switch back at processAllTransactionsEnd will be skipped
+    for (const QString & acc : orderAccountsForSweep(accounts, "", currentAccount) ) {
+            eventCollector->addTask(new TaskAccountSwitch(this, acc), TaskAccountSwitch::TIMEOUT);
             eventCollector->addTask(new TaskAllTransactions(this), TaskAllTransactions::TIMEOUT);
     }
-    eventCollector->addTask( task, -1 );
+    eventCollector->addTask( endTask, -1 );
 }
 
 // Get root public key with signed message. Message is optional, can be empty
@@ -919,18 +1081,31 @@ void MWC713::verifyMwcBoxTransactionProof( QString proofFileName )  {
     eventCollector->addTask( new TaskTransVerifyProof(this, proofFileName), TaskTransExportProof::TIMEOUT );
 }
 
+// Node status younger than that is good enough for the windows and states that just need to know the height
+static const int64_t NODE_STATUS_CACHE_MS = 5*1000;
+
 // Status of the node
 // Check Signal: onNodeSatatus( bool online, QString errMsg, int height, int64_t totalDifficulty, int connections )
-bool MWC713::getNodeStatus() {
+bool MWC713::getNodeStatus(bool useCached) {
     if ( !isWalletRunningAndLoggedIn() )
         return false; // ignoring request
 
+    if ( useCached && lastNodeStatus.updateTime > 0 &&
+            QDateTime::currentMSecsSinceEpoch() - lastNodeStatus.updateTime < NODE_STATUS_CACHE_MS ) {
+        logger::logEmit( "MWC713", "onNodeStatus", "cached, NodeHeight="+QString::number(lastNodeStatus.nodeHeight) );
+        emit onNodeStatus( lastNodeStatus.online, lastNodeStatus.errMsg, lastNodeStatus.nodeHeight, lastNodeStatus.peerHeight,
+                           lastNodeStatus.totalDifficulty, lastNodeStatus.connections );
+        return true;
+    }
+
     Mwc713Task * task = new TaskNodeInfo(this);
     if ( eventCollector->hasTask(task) ) {
         delete task;
         return true;
     }
 
+    // Status polling can wait for anything else
+    TaskBatchScope batch(eventCollector, TASK_PRIORITY::HOUSEKEEPING);
     eventCollector->addTask( task, TaskNodeInfo::TIMEOUT );
     return true;
 }
@@ -967,6 +1142,7 @@ void MWC713::setLoginResult(bool ok) {
     if (ok) {
         // Setting receive acocunt...
         const WalletConfig & config = getWalletConfig();
+        dataCache.setWalletDataPath(config.getDataPath());
         switchAccount(appContext->getCurrentAccountName(config.getDataPath()));
         setReceiveAccount( appContext->getReceiveAccount(config.getDataPath()) );
     }
@@ -1070,6 +1246,9 @@ void MWC713::setMwcMqListeningStatus(bool online, QString tid, bool startStopEve
 
     if (mwcMqOnline != online) {
         appendNotificationMessage( notify::MESSAGE_LEVEL::INFO, (online ? "Start " : "Stop ") + QString("listening on MWC MQS") );
+        // Slates that was sent while we was offline can be delivered now
+        if (online)
+            balanceChangedAll = true;
     }
     mwcMqOnline = online;
     logger::logEmit("MWC713", "onListenersStatus", QString(mwcMqOnline ? "true" : "false") + " " + QString(keybaseOnline ? "true" : "false") + " " + QString(torOnline ? "true" : "false") );
@@ -1080,6 +1259,8 @@ void MWC713::setMwcMqListeningStatus(bool online, QString tid, bool startStopEve
 void MWC713::setKeybaseListeningStatus(bool online) {
     if (keybaseOnline != online) {
         appendNotificationMessage( notify::MESSAGE_LEVEL::INFO, (online ? "Start " : "Stop ") + QString("listening on keybase"));
+        if (online)
+            balanceChangedAll = true;
     }
     keybaseOnline = online;
     logger::logEmit("MWC713", "onListenersStatus", QString(mwcMqOnline ? "true" : "false") + " " + QString(keybaseOnline ? "true" : "false") + " " + QString(torOnline ? "true" : "false") );
@@ -1089,6 +1270,8 @@ void MWC713::setKeybaseListeningStatus(bool online) {
 void MWC713::setTorListeningStatus(bool online) {
     if (torOnline != online) {
         appendNotificationMessage( notify::MESSAGE_LEVEL::INFO, (online ? "Start " : "Stop ") + QString(" Tor listener"));
+        if (online)
+            balanceChangedAll = true;
     }
     torOnline = online;
     logger::logEmit("MWC713", "onListenersStatus", QString(mwcMqOnline ? "true" : "false") + " " + QString(keybaseOnline ? "true" : "false") + " " + QString(torOnline ? "true" : "false") );
@@ -1137,14 +1320,30 @@ void MWC713::setRecoveryProgress( int64_t progress, int64_t limit ) {
 // Apply account list. Exploring what does wallet has
 void MWC713::updateAccountList( QVector<QString> accounts ) {
     collectedAccountInfo.clear();
+    collectedAccountOrder = accounts;
 
+    scheduleAccountsInfo(accounts);
+}
+
+// Refresh some accounts only. Others keep the data from the last refresh
+void MWC713::updatePartialAccountList( QVector<QString> accounts ) {
+    collectedAccountInfo = accountInfoNoLocks;
+    collectedAccountOrder.clear();
+    for (const AccountInfo & acc : accountInfoNoLocks)
+        collectedAccountOrder.push_back(acc.accountName);
+
+    scheduleAccountsInfo(accounts);
+}
+
+void MWC713::scheduleAccountsInfo( const QVector<QString> & accounts ) {
     core::SendCoinsParams params = appContext->getSendCoinsParams();
 
     QVector<AccountInfo> accountInfo;
 
     int idx = 0;
     int taskIdx = 0;
-    for (QString acc : accounts) {
+    // Starting from the active account and finishing with current one, so the first and last switches will be skipped.
+    for (QString acc : orderAccountsForSweep(accounts, eventCollector->getActiveAccount(), currentAccount)) {
         eventCollector->addTask( new TaskAccountSwitch(this, acc), TaskAccountSwitch::TIMEOUT, taskIdx++ );
         eventCollector->addTask( new TaskAccountInfo(this, params.inputConfirmationNumber ), TaskAccountInfo::TIMEOUT, taskIdx++ );
         eventCollector->addTask( new TaskAccountProgress(this, idx++, accounts.size() ), -1, taskIdx++ ); // Updating the progress
@@ -1159,8 +1358,28 @@ void MWC713::updateAccountProgress(int accountIdx, int totalAccounts) {
 }
 
 void MWC713::updateAccountFinalize() {
-    accountInfoNoLocks = collectedAccountInfo;
+    // Restoring the mwc713 accounts order
+    accountInfoNoLocks.clear();
+    for (const QString & accName : collectedAccountOrder) {
+        for (const AccountInfo & acc : collectedAccountInfo) {
+            if (acc.accountName == accName) {
+                accountInfoNoLocks.push_back(acc);
+                break;
+            }
+        }
+    }
     collectedAccountInfo.clear();
+    collectedAccountOrder.clear();
+
+    // Transactions index for search is persistent by the data cache. New accounts are loaded from it
+    for (const AccountInfo & acc : accountInfoNoLocks) {
+        if (txIndex.hasAccount(acc.accountName))
+            continue;
+        int64_t height = 0;
+        QVector<WalletTransaction> transactions;
+        if (dataCache.getTransactions(acc.accountName, height, transactions))
+            txIndex.setTransactions(acc.accountName, transactions);
+    }
 
     Q_ASSERT(hodlStatus);
     hodlStatus->finishWalletOutputs();
@@ -1190,6 +1409,26 @@ void MWC713::updateAccountFinalize() {
     // !!!!!! NOTE, 'false' mean that we don't save to that account. It make sence because during such long operation
     //  somebody could change account
     eventCollector->addTask( new TaskAccountSwitch(this, currentAccount), TaskAccountSwitch::TIMEOUT, 0 );
+
+    indexMissingAccounts();
+}
+
+// Accounts that were never opened or opened with cache disabled are not in the index. Search needs them,
+// so they are requested at the background. setTransactions will add them to the index.
+void MWC713::indexMissingAccounts() {
+    for (const AccountInfo & acc : accountInfoNoLocks) {
+        if (txIndex.hasAccount(acc.accountName) || indexingAccounts.contains(acc.accountName))
+            continue;
+
+        logger::logInfo("MWC713", "Requesting transactions for the search index, account " + acc.accountName);
+        indexingAccounts.insert(acc.accountName);
+
+        TaskBatchScope batch(eventCollector, TASK_PRIORITY::BACKGROUND, acc.accountName);
+        eventCollector->addTask( new TaskAccountSwitch(this, acc.accountName), TaskAccountSwitch::TIMEOUT );
+        eventCollector->addTask( new TaskTransactions(this), TaskTransactions::TIMEOUT );
+        if (acc.accountName != currentAccount)
+            eventCollector->addTask( new TaskAccountSwitch(this, currentAccount), TaskAccountSwitch::TIMEOUT );
+    }
 }
 
 void MWC713::createNewAccount( QString newAccountName ) {
@@ -1215,8 +1454,15 @@ void MWC713::updateRenameAccount(const QString & oldName, const QString & newNam
         if (ai.accountName == oldName) {
             ai.accountName = newName;
             walletOutputs.insert(newName, walletOutputs.value(oldName));
+            spendableIndex.renameAccount(oldName, newName);
         }
     }
+    txIndex.renameAccount(oldName, newName);
+    if (indexingAccounts.remove(oldName))
+        indexingAccounts.insert(newName);
+
+    if (success)
+        dataCache.renameAccount(oldName, newName);
 
     if (createSimulation) {
         logger::logEmit( "MWC713", "onAccountCreated",newName);
@@ -1287,6 +1533,17 @@ void MWC713::reportSlateReceivedFrom( QString slate, QString mwc, QString fromAd
 
     emit onSlateReceivedFrom(slate, mwc, fromAddr, message );
 
+    // mwc713 will list this transaction with the next transactions request. Until that it is searchable as pending
+    WalletTransaction pending;
+    pending.transactionType = WalletTransaction::TRANSACTION_TYPE::RECEIVE;
+    pending.txid = slate;
+    pending.address = fromAddr;
+    pending.creationTime = QDateTime::currentDateTime().toString(mwc::DATETIME_TEMPLATE_THIS);
+    pending.coinNano = util::one2nano(mwc).second;
+    txIndex.addPendingTransaction(recieveAccount, pending);
+
+    balanceChangedAll = true;
+
     updateWalletBalance(false,true);
 
     // We no longer display a message box with the receive message
@@ -1311,6 +1568,7 @@ void MWC713::setSendFileResult( bool success, QStringList errors, QString fileNa
 void MWC713::setReceiveFile( bool success, QStringList errors, QString inFileName, QString outFn ) {
     if (success) {
         appendNotificationMessage(notify::MESSAGE_LEVEL::INFO, QString("File receive transaction was processed for " + inFileName));
+        balanceChangedAll = true;
     }
 
     logger::logEmit( "MWC713", "onReceiveFile", "success="+QString::number(success) );
@@ -1320,6 +1578,7 @@ void MWC713::setReceiveFile( bool success, QStringList errors, QString inFileNam
 void MWC713::setFinalizeFile( bool success, QStringList errors, QString fileName ) {
     if (success) {
         appendNotificationMessage(notify::MESSAGE_LEVEL::INFO, QString("File finalized for " + fileName));
+        balanceChangedAll = true;
     }
 
     logger::logEmit( "MWC713", "onFinalizeFile", "success="+QString::number(success) );
@@ -1329,6 +1588,7 @@ void MWC713::setFinalizeFile( bool success, QStringList errors, QString fileName
 void MWC713::setSubmitFile(bool success, QString message, QString fileName) {
     if (success) {
         appendNotificationMessage(notify::MESSAGE_LEVEL::INFO, QString("Published transaction for " + fileName));
+        balanceChangedAll = true;
     }
 
     logger::logEmit( "MWC713", "setSubmitFile", "success="+QString::number(success) );
@@ -1336,6 +1596,12 @@ void MWC713::setSubmitFile(bool success, QString message, QString fileName) {
 }
 
 void MWC713::setTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions ) {
+    txIndex.setTransactions(account, Transactions);
+    indexingAccounts.remove(account);
+    if (!dataCache.updateTransactions(account, height, Transactions)) {
+        logger::logInfo( "MWC713", "Transactions for account " + account + " and height are the same as cached" );
+        return;
+    }
     logger::logEmit( "MWC713", "onTransactions", "account="+account );
     emit onTransactions( account, height, Transactions );
 }
@@ -1347,7 +1613,11 @@ void MWC713::setTransactionById( bool success, QString account, int64_t height,
 
 
 void MWC713::setOutputs( QString account, bool show_spent, int64_t height, QVector<WalletOutput> outputs) {
-    setWalletOutputs( account, outputs);
+    setWalletOutputs( account, height, outputs);
+    if (!dataCache.updateOutputs(account, show_spent, height, outputs)) {
+        logger::logInfo( "MWC713", "Outputs for account " + account + " and height are the same as cached" );
+        return;
+    }
     logger::logEmit( "MWC713", "onOutputs", "account="+account );
     emit onOutputs( account, show_spent, height, outputs );
 }
@@ -1363,6 +1633,8 @@ void MWC713::setVerifyProofResults( bool success, QString fn, QString msg ) {
 }
 
 void MWC713::setTransCancelResult( bool success, const QString & account, int64_t transId, QString errMsg ) {
+    if (success)
+        dirtyAccounts.insert(account);
     logger::logEmit( "MWC713", "onCancelTransacton", "success="+QString::number(success) );
     emit onCancelTransacton(success, account, transId, errMsg);
 }
@@ -1394,6 +1666,19 @@ void MWC713::setCheckResult(bool ok, QString errors) {
 void MWC713::setNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, int64_t totalDifficulty, int connections ) {
     logger::logEmit( "MWC713", "setNodeStatus", "online="+QString::number(online) + " NodeHeight="+QString::number(nodeHeight) + " PeerHeight="+QString::number(peerHeight) +
                           " totalDifficulty=" + QString::number(totalDifficulty) + " connections=" + QString::number(connections) );
+    if (online) {
+        lastNodeHeight = nodeHeight;
+        spendableIndex.setTipHeight(nodeHeight);
+    }
+
+    lastNodeStatus.online = online;
+    lastNodeStatus.errMsg = errMsg;
+    lastNodeStatus.nodeHeight = nodeHeight;
+    lastNodeStatus.peerHeight = peerHeight;
+    lastNodeStatus.totalDifficulty = totalDifficulty;
+    lastNodeStatus.connections = connections;
+    lastNodeStatus.updateTime = QDateTime::currentMSecsSinceEpoch();
+
     emit onNodeStatus( online, errMsg, nodeHeight, peerHeight, totalDifficulty, connections );
 }
 
@@ -1442,21 +1727,66 @@ void  MWC713::restartMQsListener() {
 }
 
 
-void MWC713::processAllTransactionsStart() {
+QVector<IndexedTransaction> MWC713::searchTransactions(const TransactionsQuery & query, int limit) {
+    return txIndex.search(query, limit);
+}
+
+QVector<QString> MWC713::getNotIndexedAccounts() {
+    QVector<QString> res;
+    for (const AccountInfo & acc : accountInfoNoLocks) {
+        if (!txIndex.hasAccount(acc.accountName))
+            res.push_back(acc.accountName);
+    }
+    return res;
+}
+
+void MWC713::processAllTransactionsStart(int streamId, int accountsNum) {
     collectedTransactions.clear();
+    streamTransactionsId = streamId;
+    streamAccountIdx = 0;
+    streamAccountsNum = accountsNum;
 }
 
-void MWC713::processAllTransactionsAppend(const QVector<WalletTransaction> & trVector) {
-    collectedTransactions.append(trVector);
+void MWC713::processAllTransactionsAppend(const QString & account, const QVector<WalletTransaction> & trVector) {
+    if (streamTransactionsId == 0) {
+        collectedTransactions.append(trVector);
+        return;
+    }
+
+    // Export can be huge, passing the data as it comes
+    logger::logEmit("MWC713", "onAllTransactionsChunk", account + " " + QString::number(streamAccountIdx) + "/" +
+                    QString::number(streamAccountsNum) + " size=" + QString::number(trVector.size()) );
+    emit onAllTransactionsChunk(streamTransactionsId, account, streamAccountIdx, qMax(streamAccountsNum, streamAccountIdx+1), trVector);
+    streamAccountIdx++;
 }
 
-void MWC713::processAllTransactionsEnd() {
-    emit onAllTransactions(collectedTransactions);
+void MWC713::processAllTransactionsEnd(int streamId) {
+    if (streamId > 0) {
+        pendingStreams.removeOne(streamId);
+        logger::logEmit("MWC713", "onAllTransactionsStreamEnd", "stream=" + QString::number(streamId) + " accounts=" + QString::number(streamAccountIdx) );
+        emit onAllTransactionsStreamEnd(streamId, true);
+    }
+    else {
+        emit onAllTransactions(collectedTransactions);
+    }
     collectedTransactions.clear();
+    streamTransactionsId = 0;
     // switching back to current account
     eventCollector->addTask( new TaskAccountSwitch(this, currentAccount), TaskAccountSwitch::TIMEOUT );
 }
 
+void MWC713::abortTransactionStreams() {
+    collectedTransactions.clear();
+    streamTransactionsId = 0;
+
+    QVector<int> streams;
+    streams.swap(pendingStreams);
+    for (int streamId : streams) {
+        logger::logEmit("MWC713", "onAllTransactionsStreamEnd", "stream=" + QString::number(streamId) + " aborted" );
+        emit onAllTransactionsStreamEnd(streamId, false);
+    }
+}
+
 void MWC713::updateSyncProgress(double progressPercent) {
     logger::logEmit("MWC713", "onUpdateSyncProgress", QString::number(progressPercent) );
 
@@ -1560,8 +1890,12 @@ void MWC713::mwc713errorOccurred(QProcess::ProcessError error) {
         QString stderrStr = mwc713process->readAllStandardError();
         logger::logInfo("MWC713", "stderr: " + stderrStr );
 
-        util::updateEventList(outputsLines, stdoutStr);
-        util::updateEventList(outputsLines, stderrStr);
+        if (outputReader) {
+            // Data that was read before must be processed first
+            outputReader->waitForProcessed();
+            outputReader->appendOutputLines(stdoutStr);
+            outputReader->appendOutputLines(stderrStr);
+        }
 
         mwc713process->deleteLater();
         mwc713process = nullptr;
@@ -1584,8 +1918,12 @@ void MWC713::mwc713finished(int exitCode, QProcess::ExitStatus exitStatus) {
         QString stderrStr = mwc713process->readAllStandardError();
         logger::logInfo("MWC713", "stderr: " + stderrStr );
 
-        util::updateEventList(outputsLines, stdoutStr);
-        util::updateEventList(outputsLines, stderrStr);
+        if (outputReader) {
+            // Data that was read before must be processed first
+            outputReader->waitForProcessed();
+            outputReader->appendOutputLines(stdoutStr);
+            outputReader->appendOutputLines(stderrStr);
+        }
 
         mwc713process->deleteLater();
         mwc713process = nullptr;
@@ -1608,6 +1946,9 @@ void MWC713::mwc713finished(int exitCode, QProcess::ExitStatus exitStatus) {
             // Very likely that wallet wasn't be able to start. Lets update the message with mode details
 
             QString walletErrMsg;
+            QList<QString> outputsLines;
+            if (outputReader)
+                outputsLines = outputReader->getOutputLines();
             if (outputsLines.size()>0) {
                 // Check if there are erorrs or warnings...
                 QList<QString> filteredOutput;
@@ -1635,8 +1976,10 @@ void MWC713::mwc713finished(int exitCode, QProcess::ExitStatus exitStatus) {
     if (startedMode == STARTED_MODE::RECOVER) {
         // We are good, just a wrong passphrase. We need to report it correctly.
         // let's feed outputsLines to the parser
-        inputParser->processInput(outputsLines.join("\n") );
-        inputParser->processInput("\n" + mwc::PROMPTS_MWC713 + "\n");
+        if (outputReader) {
+            outputReader->pushParserInput(outputReader->getOutputLines().join("\n"));
+            outputReader->pushParserInput("\n" + mwc::PROMPTS_MWC713 + "\n");
+        }
     }
     else {
         appendNotificationMessage(notify::MESSAGE_LEVEL::FATAL_ERROR,
@@ -1656,42 +1999,11 @@ void MWC713::mwc713readyReadStandardError() {
 }
 
 void MWC713::mwc713readyReadStandardOutput() {
-    if (mwc713process==nullptr)
+    if (mwc713process==nullptr || outputReader==nullptr)
         return;
 
-    QString str( ioutils::FilterEscSymbols( mwc713process->readAllStandardOutput() ) );
-    qDebug() << "Get output:" << str;
-    logger::logMwc713out(str);
-
-    // Let's filter out the possible prompt from the editor it can be located anywhere
-    // To filter out:  'wallet713>'
-    auto lns = str.split(QRegExp("[\r\n]"),QString::SkipEmptyParts);
-
-    QString filteredStr;
-    for (auto ln : lns) {
-        if (ln.startsWith("wallet713>"))
-            ln = ln.mid(strlen("wallet713>")).trimmed();
-
-        if (!filteredStr.isEmpty())
-            filteredStr += "\n";
-        filteredStr += ln;
-
-        if (!ln.isEmpty()) {
-            while(outputsLines.size()>outputsLinesBufferSize)
-                outputsLines.pop_front();
-
-            outputsLines.push_back(ln);
-        }
-    }
-
-    if (str.size()>0 && (str[0] == '\n' || str[0] == '\r') )
-        filteredStr = "\n" + filteredStr;
-
-    if ( str.size()>0 && (str[str.size()-1] == '\n' || str[str.size()-1] == '\r') ) {
-        filteredStr += "\n";
-    }
-
-    inputParser->processInput(filteredStr);
+    // Filtering, logging and parsing are done at the reader thread
+    outputReader->pushOutput( mwc713process->readAllStandardOutput() );
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -1912,6 +2224,15 @@ bool MWC713::setWalletConfig( const WalletConfig & _config, bool canStartNode )
 void MWC713::onOutputLockChanged(QString commit) {
     qDebug() << "MWC713 Get onOutputLockChanged for " << commit;
 
+    for (auto acc = walletOutputs.constBegin(); acc != walletOutputs.constEnd(); ++acc) {
+        for (const auto & out : acc.value()) {
+            if (out.outputCommitment == commit) {
+                spendableIndex.invalidate(acc.key());
+                break;
+            }
+        }
+    }
+
     logger::logEmit( "MWC713", "onWalletBalanceUpdated", "origin from onOutputLockChanged, commit=" + commit );
     emit onWalletBalanceUpdated();
 
@@ -1932,7 +2253,7 @@ QVector<AccountInfo> MWC713::applyOutputLocksToBalance() const {
         // Checking Outputs if they locked
         const QVector<wallet::WalletOutput> & accountOutputs = walletOutputs.value(ai.accountName);
         for ( const wallet::WalletOutput & out : accountOutputs ) {
-            int64_t dh = ai.height - out.blockHeight.toLongLong();
+            int64_t dh = ai.height - out.blockHeight;
             if (dh < int64_t(confNumber) )
                 continue;
 
@@ -1946,8 +2267,13 @@ QVector<AccountInfo> MWC713::applyOutputLocksToBalance() const {
     return accountInfoWithLocks;
 }
 
-void MWC713::setWalletOutputs( const QString & account, const QVector<wallet::WalletOutput> & outputs) {
+void MWC713::setWalletOutputs( const QString & account, int64_t height, const QVector<wallet::WalletOutput> & outputs) {
     walletOutputs[account] = outputs;
+    spendableIndex.setOutputs(account, height);
+}
+
+const SpendableOutputs & MWC713::getSpendableOutputs(const QString & accountName) {
+    return spendableIndex.get(accountName, walletOutputs.value(accountName), appContext);
 }
 
 
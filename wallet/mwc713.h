@@ -18,8 +18,12 @@
 #include "wallet.h"
 #include <QObject>
 #include <QProcess>
+#include <QSet>
 #include <core/HodlStatus.h>
 #include "../core/global.h"
+#include "mwc713cache.h"
+#include "spendableoutputs.h"
+#include "transactionsindex.h"
 
 namespace tries {
     class Mwc713InputParser;
@@ -32,6 +36,7 @@ class AppContext;
 namespace wallet {
 
 class Mwc713EventManager;
+class Mwc713OutputReader;
 
 class MWC713 : public Wallet
 {
@@ -146,6 +151,8 @@ public:
     // Get outputs that was collected for this wallet. Outputs should be ready with balances
     virtual const QMap<QString, QVector<wallet::WalletOutput> > & getwalletOutputs() const override {return walletOutputs;}
 
+    virtual const SpendableOutputs & getSpendableOutputs(const QString & accountName) override;
+
     virtual QString getCurrentAccountName()  override {return currentAccount;}
 
     // Request sync (update_wallet_state) for the
@@ -156,6 +163,10 @@ public:
     // Check signal: onWalletBalanceUpdated
     //          onWalletBalanceProgress
 
+    // Request Wallet balance update only for accounts that might change since the last refresh
+    virtual void updateWalletBalanceIfChanged(bool enforceSync) override;
+    // Check signal: onWalletBalanceUpdated
+
 
     // Create another account, note no delete exist for accounts
     virtual void createAccount( const QString & accountName )  override;
@@ -191,7 +202,7 @@ public:
     // Status of the node
     // return true if task was scheduled
     // Check Signal: onNodeSatatus( bool online, QString errMsg, int height, int64_t totalDifficulty, int connections )
-    virtual bool getNodeStatus() override;
+    virtual bool getNodeStatus(bool useCached) override;
 
     // -------------- Transactions
 
@@ -259,6 +270,13 @@ public:
     // Check Signal: onAllTransactions( QVector<WalletTransaction> Transactions)
     virtual void getAllTransactions() override;
 
+    // Read transactions account by account. account - account to read, empty for all accounts.
+    // Check Signals: onAllTransactionsChunk, onAllTransactionsStreamEnd
+    virtual int streamAllTransactions(QString account) override;
+
+    virtual QVector<IndexedTransaction> searchTransactions(const TransactionsQuery & query, int limit) override;
+    virtual QVector<QString> getNotIndexedAccounts() override;
+
     // Get root public key with signed message. Message is optional, can be empty
     // Check Signal: onRootPublicKey( QString rootPubKey, QString message, QString signature )
     virtual void getRootPublicKey( QString message2sign ) override;
@@ -361,6 +379,7 @@ public:
 
     // Update account feedback
     void updateAccountList( QVector<QString> accounts );
+    void updatePartialAccountList( QVector<QString> accounts );
     void updateAccountProgress(int accountIdx, int totalAccounts);
     void updateAccountFinalize();
     void createNewAccount( QString newAccountName );
@@ -390,7 +409,7 @@ public:
     // Outputs results
     void setOutputs( QString account, bool show_spent, int64_t height, QVector<WalletOutput> outputs);
 
-    void setWalletOutputs( const QString & account, const QVector<WalletOutput> & outputs);
+    void setWalletOutputs( const QString & account, int64_t height, const QVector<WalletOutput> & outputs);
 
     void setExportProofResults( bool success, QString fn, QString msg );
     void setVerifyProofResults( bool success, QString fn, QString msg );
@@ -410,9 +429,10 @@ public:
     void notifyMqFailedToStart();
 
     //-------------
-    void processAllTransactionsStart();
-    void processAllTransactionsAppend(const QVector<WalletTransaction> & trVector);
-    void processAllTransactionsEnd();
+    // streamId - 0 for getAllTransactions, otherwise streamAllTransactions id
+    void processAllTransactionsStart(int streamId, int accountsNum);
+    void processAllTransactionsAppend(const QString & account, const QVector<WalletTransaction> & trVector);
+    void processAllTransactionsEnd(int streamId);
 
     // -----------------
     void updateSyncProgress(double progressPercent);
@@ -471,6 +491,17 @@ private slots:
     void    onOutputLockChanged(QString commit);
 private:
 
+    // Schedule info requests for accounts. Expected to be called from the running task.
+    void scheduleAccountsInfo( const QVector<QString> & accounts );
+    // Schedule transactions requests for the accounts. streaming - emit per account, don't collect
+    void scheduleAllTransactions(const QVector<QString> & accounts, int streamId, Mwc713Task * endTask);
+    // Request transactions for the accounts that are missing in txIndex
+    void indexMissingAccounts();
+    // Streams that are not finished will never get their data, reporting them as aborted
+    void abortTransactionStreams();
+    // Full balance refresh was scheduled, nothing is dirty any more
+    void resetBalanceChanges();
+
     // process accountInfoNoLocks, apply locked outputs
     QVector<AccountInfo> applyOutputLocksToBalance() const;
 
@@ -493,9 +524,8 @@ private:
     QString mwc713Path; // path to the backed binary
     QString mwc713configPath; // config file for mwc713
     QProcess * mwc713process = nullptr;
-    tries::Mwc713InputParser * inputParser = nullptr; // Parser will generate bunch of signals that wallet will listem on
-    const int outputsLinesBufferSize = 15;
-    QList<QString> outputsLines; // Last few output lines. Will print in case of the crash
+    // Parse mwc713 output at the worker thread. Owns parser that will generate bunch of signals that wallet will listem on
+    Mwc713OutputReader * outputReader = nullptr;
 
     STARTED_MODE startedMode = STARTED_MODE::OFFLINE;
     bool   loggedIn = false; // Make sence for startedMode NORMAL. True if login was successfull
@@ -534,8 +564,32 @@ private:
 
     QMap<QString, QVector<wallet::WalletOutput> > walletOutputs; // Available outputs from this wallet. Key: account name, value outputs for this account
 
+    SpendableOutputsIndex spendableIndex; // Spendable outputs per account, built from walletOutputs
+
+    WalletDataCache dataCache; // Transactions and outputs from the last run, available after login
+    TransactionsIndex txIndex; // Transactions from all accounts for search. Loaded from dataCache and updated with the new data
+    QSet<QString> indexingAccounts; // Accounts with scheduled transactions request for txIndex
+
     int64_t lastSyncTime = 0;
 
+    // Last node status, it is shared by all getNodeStatus callers while it is fresh
+    struct NodeStatusCache {
+        bool    online = false;
+        QString errMsg;
+        int     nodeHeight = 0;
+        int     peerHeight = 0;
+        int64_t totalDifficulty = 0;
+        int     connections = 0;
+        int64_t updateTime = 0;
+    } lastNodeStatus;
+
+    // Balance refresh gate state. See updateWalletBalanceIfChanged
+    int64_t lastNodeHeight = 0;
+    int64_t balanceRefreshHeight = 0;
+    int64_t lastBalanceRefreshTime = 0;
+    bool balanceChangedAll = true;
+    QSet<QString> dirtyAccounts;
+
     WalletConfig currentConfig;
     WalletConfig defaultConfig;
 private:
@@ -543,8 +597,15 @@ private:
     QString walletPasswordHash;
 
     QVector<AccountInfo> collectedAccountInfo;
+    QVector<QString> collectedAccountOrder; // Accounts order from mwc713, info is collected in different order
 
     QVector<WalletTransaction> collectedTransactions;
+    // streamAllTransactions state. Transactions are emitted per account, not collected
+    int  streamTransactionsId = 0; // Stream in progress, 0 - collecting for getAllTransactions
+    int  streamAccountIdx = 0;
+    int  streamAccountsNum = 0;
+    int  lastStreamId = 0;
+    QVector<int> pendingStreams; // Scheduled streams without the end, in order
 
     int64_t walletStartTime = 0;
     QString commandLine;
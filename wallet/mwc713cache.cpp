@@ -0,0 +1,186 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "mwc713cache.h"
+#include <QFile>
+#include <QDir>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include "../util/ioutils.h"
+#include "../util/crypto.h"
+#include "../util/Log.h"
+
+namespace wallet {
+
+const static QString TX_KIND("tx");
+const static QString OUTPUTS_KIND("out");
+const static QString OUTPUTS_SPENT_KIND("out_spent");
+
+const static int CACHE_FILE_ID = 0x7C02; // 0x7C02 - typed output fields
+
+void WalletDataCache::setWalletDataPath(const QString & walletDataPath) {
+    cachePath = "";
+    entries.clear();
+    if (walletDataPath.isEmpty())
+        return;
+
+    QPair<bool,QString> path = ioutils::getAppDataPath( walletDataPath + "/gui_cache" );
+    if (!path.first) {
+        logger::logInfo("WalletDataCache", "Unable to use the cache, " + path.second);
+        return;
+    }
+    cachePath = path.second;
+}
+
+QString WalletDataCache::getFileName(const QString & kind, const QString & account) const {
+    // Account names can have any symbols, hash is safe for the file system
+    return cachePath + QDir::separator() + crypto::calcHSA256Hash(calcEntryKey(kind, account)) + ".dat";
+}
+
+QByteArray WalletDataCache::calcRecordsHash(const QStringList & records) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (const QString & r : records) {
+        hash.addData( reinterpret_cast<const char *>(r.constData()), r.size() * int(sizeof(QChar)) );
+        hash.addData( "\n", 1 );
+    }
+    return hash.result();
+}
+
+bool WalletDataCache::readEntry(const QString & kind, const QString & account, int64_t & height, QStringList & records) const {
+    if (cachePath.isEmpty())
+        return false;
+
+    QFile file(getFileName(kind, account));
+    if ( !file.open(QIODevice::ReadOnly) )
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_7);
+
+    int id = 0;
+    QString fileKind, fileAccount;
+    qint64 h = -1;
+    in >> id;
+    if (id != CACHE_FILE_ID)
+        return false;
+    in >> fileKind >> fileAccount >> h >> records;
+
+    if (in.status() != QDataStream::Ok || fileKind != kind || fileAccount != account) {
+        records.clear();
+        return false;
+    }
+
+    height = h;
+
+    EntryState & st = entries[calcEntryKey(kind, account)];
+    st.height = height;
+    st.hash = calcRecordsHash(records);
+    return true;
+}
+
+void WalletDataCache::writeEntry(const QString & kind, const QString & account, int64_t height, const QStringList & records) {
+    if (cachePath.isEmpty())
+        return;
+
+    QFile file(getFileName(kind, account));
+    if ( !file.open(QIODevice::WriteOnly | QIODevice::Truncate) ) {
+        logger::logInfo("WalletDataCache", "Unable to write cache file " + file.fileName() );
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_7);
+    out << CACHE_FILE_ID << kind << account << qint64(height) << records;
+
+    EntryState & st = entries[calcEntryKey(kind, account)];
+    st.height = height;
+    st.hash = calcRecordsHash(records);
+}
+
+bool WalletDataCache::updateEntry(const QString & kind, const QString & account, int64_t height, const QStringList & records) {
+    if (cachePath.isEmpty())
+        return true;
+
+    const QString key = calcEntryKey(kind, account);
+    if (!entries.contains(key)) {
+        // File is read once per session, later the state from memory is used
+        int64_t cachedHeight = -1;
+        QStringList cachedRecords;
+        readEntry(kind, account, cachedHeight, cachedRecords);
+    }
+
+    auto st = entries.constFind(key);
+    // Height must be refreshed even if data is the same, otherwise the cache and the consumers stay outdated
+    if ( st != entries.constEnd() && st->height == height && st->hash == calcRecordsHash(records) )
+        return false;
+
+    writeEntry(kind, account, height, records);
+    return true;
+}
+
+bool WalletDataCache::getTransactions(const QString & account, int64_t & height, QVector<WalletTransaction> & transactions) const {
+    QStringList records;
+    if (!readEntry(TX_KIND, account, height, records))
+        return false;
+
+    transactions.clear();
+    transactions.reserve(records.size());
+    for (const QString & r : records)
+        transactions.push_back( WalletTransaction::fromJson(r) );
+    return true;
+}
+
+bool WalletDataCache::updateTransactions(const QString & account, int64_t height, const QVector<WalletTransaction> & transactions) {
+    QStringList records;
+    records.reserve(transactions.size());
+    for (const WalletTransaction & tx : transactions)
+        records.push_back(tx.toJson());
+    return updateEntry(TX_KIND, account, height, records);
+}
+
+bool WalletDataCache::getOutputs(const QString & account, bool showSpent, int64_t & height, QVector<WalletOutput> & outputs) const {
+    QStringList records;
+    if (!readEntry(showSpent ? OUTPUTS_SPENT_KIND : OUTPUTS_KIND, account, height, records))
+        return false;
+
+    outputs.clear();
+    outputs.reserve(records.size());
+    for (const QString & r : records)
+        outputs.push_back( WalletOutput::fromJson(r) );
+    return true;
+}
+
+bool WalletDataCache::updateOutputs(const QString & account, bool showSpent, int64_t height, const QVector<WalletOutput> & outputs) {
+    QStringList records;
+    records.reserve(outputs.size());
+    for (const WalletOutput & out : outputs)
+        records.push_back(out.toJson());
+    return updateEntry(showSpent ? OUTPUTS_SPENT_KIND : OUTPUTS_KIND, account, height, records);
+}
+
+void WalletDataCache::renameAccount(const QString & oldName, const QString & newName) {
+    if (cachePath.isEmpty())
+        return;
+
+    for (const QString & kind : {TX_KIND, OUTPUTS_KIND, OUTPUTS_SPENT_KIND} ) {
+        int64_t height = -1;
+        QStringList records;
+        if (readEntry(kind, oldName, height, records)) {
+            writeEntry(kind, newName, height, records);
+            QFile::remove( getFileName(kind, oldName) );
+        }
+        entries.remove( calcEntryKey(kind, oldName) );
+    }
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC713CACHE_H
+#define MWC713CACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include "wallet.h"
+
+namespace wallet {
+
+// On disk cache of transactions and outputs per account. GUI can show the cached data
+// while mwc713 is collecting the fresh one.
+// Cache files are located at the wallet instance data folder, so instances and networks are never mixed.
+// Records are stored with toJson()
+// State of the entries that were read or written is kept in memory, so refreshes with the same data don't touch the disk.
+class WalletDataCache {
+public:
+    // Set the wallet instance. Empty path disable the cache
+    void setWalletDataPath(const QString & walletDataPath);
+
+    // Return true if cached data exist
+    bool getTransactions(const QString & account, int64_t & height, QVector<WalletTransaction> & transactions) const;
+    // Update the cache. Return true if transactions or height are different from the cached data
+    bool updateTransactions(const QString & account, int64_t height, const QVector<WalletTransaction> & transactions);
+
+    // Return true if cached data exist
+    bool getOutputs(const QString & account, bool showSpent, int64_t & height, QVector<WalletOutput> & outputs) const;
+    // Update the cache. Return true if outputs or height are different from the cached data
+    bool updateOutputs(const QString & account, bool showSpent, int64_t height, const QVector<WalletOutput> & outputs);
+
+    void renameAccount(const QString & oldName, const QString & newName);
+
+private:
+    QString getFileName(const QString & kind, const QString & account) const;
+    bool readEntry(const QString & kind, const QString & account, int64_t & height, QStringList & records) const;
+    void writeEntry(const QString & kind, const QString & account, int64_t height, const QStringList & records);
+    // Write if records or height are changed. Return true if something was changed
+    bool updateEntry(const QString & kind, const QString & account, int64_t height, const QStringList & records);
+
+    static QString calcEntryKey(const QString & kind, const QString & account) {return kind + "|" + account;}
+    static QByteArray calcRecordsHash(const QStringList & records);
+
+    struct EntryState {
+        int64_t    height = -1;
+        QByteArray hash; // calcRecordsHash of the records
+    };
+
+    QString cachePath; // Empty if cache is disabled
+    mutable QHash<QString, EntryState> entries; // calcEntryKey => state of the file. Updated on every read and write
+};
+
+}
+
+#endif // MWC713CACHE_H
@@ -21,6 +21,7 @@
 #include "../core/Config.h"
 #include "../core/Notification.h"
 #include "../core/WndManager.h"
+#include "mwc713metrics.h"
 
 namespace wallet {
 
@@ -97,6 +98,10 @@ void Mwc713EventManager::clear() {
         delete t.task;
     }
     taskQ.clear();
+    taskIndex.clear();
+    batchDepth = 0;
+    startedBatchId = 0;
+    activeAccount.clear();
     events.clear();
     taskExecutionTimeLimit = 0;
 }
@@ -109,19 +114,100 @@ void Mwc713EventManager::connectWith(tries::Mwc713InputParser * inputParser) {
     startTimer(500); // timeout checking. Twice a second is good enough for us
 }
 
+QString Mwc713EventManager::calcTaskKey(Mwc713Task * task) {
+    return task->getTaskName() + "\n" + task->getInputStr();
+}
+
 // Check if task already exist
 bool Mwc713EventManager::hasTask(Mwc713Task * task) {
+    QMutexLocker l( &taskQMutex );
+    return taskIndex.value( calcTaskKey(task), 0 ) > 0;
+}
 
+void Mwc713EventManager::beginBatch(TASK_PRIORITY priority, const QString & account) {
     QMutexLocker l( &taskQMutex );
+    if (batchDepth++ == 0) {
+        openBatchId = nextBatchId++;
+        openBatchPriority = priority;
+        openBatchAccount = account;
+    }
+}
 
-    bool found = false;
-    for ( const taskInfo & ti : taskQ ) {
-            if (ti.task->getTaskName() == task->getTaskName() && ti.task->getInputStr() == task->getInputStr()) {
-                found = true;
-                break;
-            }
+void Mwc713EventManager::endBatch() {
+    QMutexLocker l( &taskQMutex );
+    Q_ASSERT(batchDepth>0);
+    if (batchDepth>0)
+        batchDepth--;
+}
+
+// Position for a new task with the priority. Started batch and batches with the same or higher priority stay ahead.
+int Mwc713EventManager::findInsertPosition(TASK_PRIORITY priority, const QString & account) const {
+    int pos = taskQ.size();
+    // Moving back over the whole batches with lower priority
+    while ( pos>0 ) {
+        const taskInfo & ti = taskQ[pos-1];
+        if ( ti.wasStarted || ti.batchId == startedBatchId || int(ti.priority) <= int(priority) )
+            break;
+        pos--;
     }
-    return found;
+
+    if (account.isEmpty())
+        return pos;
+
+    // Grouping with the same account. Other tasks might change the data, the batch can't jump over them.
+    for (int i=pos-1; i>=0; i--) {
+        const taskInfo & ti = taskQ[i];
+        if ( ti.wasStarted || ti.batchId == startedBatchId || ti.priority != priority || ti.batchAccount.isEmpty() )
+            break;
+        if (ti.batchAccount == account)
+            return i+1; // last task of that batch
+    }
+    return pos;
+}
+
+QString Mwc713EventManager::getActiveAccount() {
+    QMutexLocker l( &taskQMutex );
+    return activeAccount;
+}
+
+// Switch is redundant if account is already active or next task switching account again.
+// Note, next switch will be started right after, so nothing can be inserted in between.
+bool Mwc713EventManager::isRedundantSwitch() const {
+    Q_ASSERT(!taskQ.isEmpty());
+    const QString switchAccount = taskQ.front().task->getSwitchAccount();
+    if (switchAccount.isEmpty())
+        return false;
+
+    if (switchAccount == activeAccount)
+        return true;
+
+    return taskQ.size()>1 && !taskQ[1].task->getSwitchAccount().isEmpty();
+}
+
+QString Mwc713EventManager::calcTimeoutKey(const Mwc713Task * task) const {
+    // Tasks are running for the active account. If it is unknown, the whole wallet is counted
+    int outputsNum = 0;
+    const QMap<QString, QVector<WalletOutput> > & outputs = mwc713wallet->getwalletOutputs();
+    if (!activeAccount.isEmpty()) {
+        outputsNum = outputs.value(activeAccount).size();
+    }
+    else {
+        for (auto it = outputs.begin(); it != outputs.end(); it++)
+            outputsNum += it->size();
+    }
+
+    // Instances and networks have different wallets and nodes
+    const WalletConfig & config = mwc713wallet->getWalletConfig();
+    return Mwc713TimeoutModel::calcKey( config.getNetwork() + ":" + config.getDataPath(), task->getTaskName(),
+                                        Mwc713TimeoutModel::calcWalletSizeClass(outputsNum) );
+}
+
+taskInfo Mwc713EventManager::takeFirstTask() {
+    taskInfo ti = taskQ.takeFirst();
+    QString key = calcTaskKey(ti.task);
+    if ( --taskIndex[key] <= 0 )
+        taskIndex.remove(key);
+    return ti;
 }
 
 
@@ -135,16 +221,44 @@ void Mwc713EventManager::addTask( Mwc713Task * task, int64_t timeout, int idx )
 
     // timeout multiplier will be applyed to the task because we want apply this value as late as posiible.
     // User might change it at any moment.
-    if (idx<0) {
-        taskQ.push_back(taskInfo(task, timeout));
-    }
-    else {
+    taskInfo ti(task, timeout);
+    ti.queuedTime = QDateTime::currentMSecsSinceEpoch();
+    int pos = taskQ.size();
+
+    if (idx>=0) {
         if (idx==0) {
             Q_ASSERT(taskQ.isEmpty() || !taskQ.front().wasStarted);
         }
-        taskQ.insert(idx, taskInfo(task, timeout));
+        // Continuation of the running batch
+        ti.batchId = startedBatchId;
+        ti.priority = startedBatchPriority;
+        pos = qMin(idx, taskQ.size());
+    }
+    else if (batchDepth>0) {
+        ti.batchId = openBatchId;
+        ti.priority = openBatchPriority;
+        ti.batchAccount = openBatchAccount;
+        // Keep the batch together. The first task define the position of the whole batch.
+        pos = -1;
+        for (int i=taskQ.size()-1; i>=0; i--) {
+            if (taskQ[i].batchId == openBatchId) {
+                pos = i+1;
+                break;
+            }
+        }
+        if (pos<0)
+            pos = findInsertPosition(ti.priority, ti.batchAccount);
+    }
+    else {
+        ti.batchId = nextBatchId++;
+        ti.priority = TASK_PRIORITY::INTERACTIVE;
+        pos = findInsertPosition(ti.priority);
     }
 
+    taskQ.insert(pos, ti);
+    taskIndex[calcTaskKey(task)]++;
+    getTaskMetrics().taskQueued(taskQ.size());
+
     processNextTask();
 
     if (taskExecutionTimeLimit==0) {
@@ -160,7 +274,13 @@ int Mwc713EventManager::cancelTasksInQueue() {
         return 0;
     }
 
-    taskQ.resize(1);
+    while (taskQ.size()>1) {
+        taskInfo ti = taskQ.takeLast();
+        QString key = calcTaskKey(ti.task);
+        if ( --taskIndex[key] <= 0 )
+            taskIndex.remove(key);
+        delete ti.task;
+    }
     return taskQ[0].timeout;
 }
 
@@ -172,6 +292,16 @@ void Mwc713EventManager::processNextTask() {
     if (taskQ.empty())
         return; // Nothing to process
 
+    // Account switches that doesn't change anything are dropped without round trip to mwc713
+    while (!taskQ.empty() && !taskQ.front().wasStarted && isRedundantSwitch()) {
+        taskInfo ti = takeFirstTask();
+        logger::logTask( "Mwc713EventManager", ti.task, "Skipped, not needed" );
+        delete ti.task;
+    }
+
+    if (taskQ.empty())
+        return;
+
     // Check if we can perform the first task
     taskInfo & task = taskQ.front();
     if (!task.wasStarted) {
@@ -180,6 +310,9 @@ void Mwc713EventManager::processNextTask() {
 
         qDebug() << "Executing the task: " + task.task->toDbgString();
         task.wasStarted = true; // reset state first, then process
+        startedBatchId = task.batchId;
+        startedBatchPriority = task.priority;
+        task.startTime = QDateTime::currentMSecsSinceEpoch();
         taskExecutionTimeLimit = 0;
 
         QStringList taskList;
@@ -192,6 +325,10 @@ void Mwc713EventManager::processNextTask() {
         task.task->onStarted();
 
         if (task.timeout > 0) {
+            // Hardcoded timeout is used until the model learn how long this task normally takes
+            task.timeoutKey = calcTimeoutKey(task.task);
+            task.timeout = int( getTimeoutModel().getTimeout( task.timeoutKey, task.timeout, task.task->isNetworkBound() ) );
+
             // schedule the task for execution
             if (!task.task->getInputStr().isEmpty()) {
                 mwc713wallet->executeMwc713command(task.task->getInputStr(), task.task->getShadowStr());
@@ -200,7 +337,7 @@ void Mwc713EventManager::processNextTask() {
         }
         else {
             // execute the task now. Next task will be started
-            executeTask(taskQ.takeFirst());
+            executeTask(takeFirstTask());
         }
     }
 }
@@ -230,15 +367,24 @@ void Mwc713EventManager::timerEvent(QTimerEvent *event) {
                           "Let mwc713 more time to process task '" + taskName + "'",
                           "Cancel task '" + taskName + "' and restart mwc713 even it can corrupt mwc713 data",
                           true, false) == core::WndManager::RETURN_CODE::BTN1) {
-            config::increaseTimeoutMultiplier();
-            // Update the waiting time
+            // Update the waiting time. Only for this task, other commands has their own timeouts.
+            // If the task finish, the model will learn that it can be slow.
 
             // Note, here we might already have another task.
-            if (!taskQ.isEmpty())
-                taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() +  (int64_t)(taskQ.front().timeout * config::getTimeoutMultiplier());
+            if (!taskQ.isEmpty()) {
+                taskInfo & front = taskQ.front();
+                front.timeout *= 2;
+                taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() +  (int64_t)(front.timeout * config::getTimeoutMultiplier());
+            }
             return;
         }
 
+        // Task is abandoned, the model never see it finished. It took at least that long.
+        if (!taskQ.isEmpty() && taskQ.front().startTime>0) {
+            const taskInfo & front = taskQ.front();
+            getTimeoutModel().addExecution( front.timeoutKey, QDateTime::currentMSecsSinceEpoch() - front.startTime );
+        }
+
         // report timeout error. Do it once
         taskExecutionTimeLimit = 0;
         notify::appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR,
@@ -268,7 +414,19 @@ void Mwc713EventManager::slReceiveEvent( WALLET_EVENTS event, QString message) {
     if (taskQ.isEmpty())
         return;
 
+    taskInfo & front = taskQ.front();
+    if (front.firstEventTime==0)
+        front.firstEventTime = QDateTime::currentMSecsSinceEpoch();
+    if (event == WALLET_EVENTS::S_LINE)
+        front.lines++;
+    front.bytes += message.size();
+
+    // Streaming tasks parse the data as it comes, no needs to keep it
+    if ( front.wasStarted && front.task->consumeEvent( WEvent(event, message) ) )
+        return;
+
     events.push_back(WEvent(event, message));
+
     qDebug() << "Mwc713EventManager::sReceiveEvent adding Event into the list. event=" << event << " msg='"
              << message << "'  New size:" << events.size();
 
@@ -276,7 +434,7 @@ void Mwc713EventManager::slReceiveEvent( WALLET_EVENTS event, QString message) {
     if (!taskQ.front().task->getReadyEvents().contains(event))
         return; // still waiting for events
 
-    executeTask(taskQ.takeFirst());
+    executeTask(takeFirstTask());
 }
 
 void Mwc713EventManager::executeTask(taskInfo task) {
@@ -284,11 +442,29 @@ void Mwc713EventManager::executeTask(taskInfo task) {
     taskExecutionTimeLimit = 0; // stopping timeout
     qDebug() << "Processing task '" << task.task->getTaskName() << "'";
 
-    logger::logTask("Mwc713EventManager", task.task, "Executing");
+    // Only tasks that were waiting for mwc713 are interesting for metrics
+    if (task.timeout>0 && task.startTime>0) {
+        const int64_t now = QDateTime::currentMSecsSinceEpoch();
+        const int64_t readyMs = now - task.startTime;
+        getTaskMetrics().taskFinished( task.task->getTaskName(), task.startTime - task.queuedTime,
+                    task.firstEventTime==0 ? -1 : task.firstEventTime - task.startTime, readyMs, task.lines, task.bytes );
+        getTimeoutModel().addExecution( task.timeoutKey, readyMs );
+        logger::logTask("Mwc713EventManager", task.task, "Executing, ready in " + QString::number(readyMs) + " ms, lines: " + QString::number(task.lines));
+    }
+    else {
+        logger::logTask("Mwc713EventManager", task.task, "Executing");
+    }
 
     // Reset before processing because processing might tale some time
-    QVector<WEvent> evts(events);
-    events.clear();
+    QVector<WEvent> evts;
+    evts.swap(events);
+
+    // Update active account before processing, processing can add more switches
+    const QString switchAccount = task.task->getSwitchAccount();
+    if (!switchAccount.isEmpty())
+        activeAccount = filterEvents(evts, WALLET_EVENTS::S_GENERIC_ERROR).isEmpty() ? switchAccount : "";
+    else if (task.task->resetsActiveAccount())
+        activeAccount = "";
 
     task.task->processTask(evts);
     delete task.task;
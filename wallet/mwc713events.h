@@ -19,6 +19,7 @@
 #include <QVector>
 #include <QObject>
 #include <QMutex>
+#include <QHash>
 
 namespace tries {
     class Mwc713InputParser;
@@ -107,10 +108,24 @@ struct WEvent {
     WEvent & operator = (const WEvent &) = default;
 };
 
+// Scheduling classes for the tasks. Not started batches with higher priority are executed first.
+enum class TASK_PRIORITY { INTERACTIVE = 0, BACKGROUND = 1, HOUSEKEEPING = 2 };
+
 struct taskInfo {
     Mwc713Task* task = nullptr; // task
     bool        wasStarted   = false;
-    int         timeout = -1; // timeout for this task
+    int         timeout = -1; // timeout for this task. Replaced with learned value when task is started
+    QString     timeoutKey; // Mwc713TimeoutModel key, calculated when task was started
+    TASK_PRIORITY priority = TASK_PRIORITY::INTERACTIVE;
+    int64_t     batchId = 0; // Tasks from the same batch are never split by other tasks
+    QString     batchAccount; // Account of the self-contained batch, see beginBatch
+
+    // Metrics data, times are in ms since epoch
+    int64_t     queuedTime = 0;
+    int64_t     startTime = 0;
+    int64_t     firstEventTime = 0;
+    int         lines = 0; // S_LINE events
+    int64_t     bytes = 0; // size of events messages
 
     taskInfo() = default;
     taskInfo(Mwc713Task* _task, int _timeout) : task(_task), timeout(_timeout) {}
@@ -119,7 +134,8 @@ struct taskInfo {
 };
 
 // Aggregator for Wallet events. Expected that there are not many events are aggregating.
-// That is whay we are not maintaining any indexes.
+// Tasks are scheduled by batches. Every task that is added outside of the batch is a batch with INTERACTIVE priority.
+// Batch that is not started yet can be moved behind the batches with higher priority.
 class Mwc713EventManager : public QObject
 {
     Q_OBJECT
@@ -138,11 +154,22 @@ public:
     // Note:  if timeout <= 0, task will be executed immediately
     //   idx == -1 - push_back, otherwise will insert into the index position
     // Return: true if task was added.  False - was ignored
+    //   Tasks that are inserted by index are continuation of the running batch.
     void addTask( Mwc713Task * task, int64_t timeout, int idx = -1);
 
-    // Check if task already exist
+    // Tasks that are added until endBatch() are scheduled as a single batch with a given priority.
+    // Nested batches are joined with the outer one.
+    // account - batch switches to this account, reads the data and switches back. It doesn't depend on
+    //    other such batches, so it is queued next to the batches for the same account to save the switches.
+    void beginBatch(TASK_PRIORITY priority, const QString & account = "");
+    void endBatch();
+
+    // Check if task already exist. Pending tasks are indexed by name and input, so it is cheap.
     bool hasTask(Mwc713Task * task);
 
+    // Account that is active at mwc713 now. Empty if unknown.
+    QString getActiveAccount();
+
     const QVector<WEvent> & getEvents() const {return events;}
 
     // Cancelling all tasks except the current one. Return timeout valiue that needed to wait
@@ -163,6 +190,19 @@ private:
     // Execute this task and start the next one
     void executeTask(taskInfo task);
 
+    // Position for a new task with the priority. Started batch and batches with the same or higher priority stay ahead.
+    // Batch for the account goes after the last batch for the same account if only account batches are in between.
+    int findInsertPosition(TASK_PRIORITY priority, const QString & account = "") const;
+    // Remove the first task from the queue and the index
+    taskInfo takeFirstTask();
+    // Check if the first task is account switch that can be skipped
+    bool isRedundantSwitch() const;
+
+    static QString calcTaskKey(Mwc713Task * task);
+
+    // Key for timeouts model: wallet, task and size of the active account
+    QString calcTimeoutKey(const Mwc713Task * task) const;
+
 private:
     // Wallet
     MWC713 * mwc713wallet = nullptr;
@@ -174,6 +214,17 @@ private:
 
     QMutex taskQMutex; // recursive
     QVector< taskInfo > taskQ; // Owner of the tasks
+    QHash< QString, int > taskIndex; // Key from calcTaskKey => number of such tasks in taskQ
+
+    int           batchDepth = 0; // Open batches number
+    int64_t       openBatchId = 0;
+    TASK_PRIORITY openBatchPriority = TASK_PRIORITY::INTERACTIVE;
+    QString       openBatchAccount;
+    int64_t       nextBatchId = 1;
+    int64_t       startedBatchId = 0; // Batch of the last started task
+    TASK_PRIORITY startedBatchPriority = TASK_PRIORITY::INTERACTIVE;
+
+    QString       activeAccount; // Account that mwc713 has active, updated by account switch tasks. Empty - unknown
 
     // Events for a new task
     QVector<WEvent> events;
@@ -181,6 +232,18 @@ private:
     volatile qint64 taskExecutionTimeLimit = 0; // Timeout value for the task
 };
 
+// Tasks that are added at the scope are scheduled as a single batch
+class TaskBatchScope {
+public:
+    TaskBatchScope(Mwc713EventManager * _eventManager, TASK_PRIORITY priority, const QString & account = "") : eventManager(_eventManager) { eventManager->beginBatch(priority, account); }
+    ~TaskBatchScope() { eventManager->endBatch(); }
+
+    TaskBatchScope(const TaskBatchScope & ) = delete;
+    TaskBatchScope & operator=(const TaskBatchScope & ) = delete;
+private:
+    Mwc713EventManager * eventManager;
+};
+
 }
 
 // Using in stots
@@ -0,0 +1,290 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "mwc713metrics.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QFile>
+#include <QDateTime>
+#include <QDataStream>
+#include <algorithm>
+#include <limits>
+#include "../util/ioutils.h"
+
+namespace wallet {
+
+static int calcBucket(qint64 value) {
+    int bucket = 0;
+    while (value>0 && bucket<Log2Histogram::BUCKETS-1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void Log2Histogram::add(qint64 value) {
+    if (value<0)
+        value = 0;
+    buckets[calcBucket(value)]++;
+    count++;
+    sum += quint64(value);
+    maxValue = qMax(maxValue, value);
+}
+
+qint64 Log2Histogram::percentile(double p) const {
+    if (count==0)
+        return 0;
+
+    quint64 limit = quint64(p * count + 0.5);
+    limit = qMax(limit, quint64(1));
+
+    quint64 cnt = 0;
+    for (int i=0; i<BUCKETS; i++) {
+        cnt += buckets[i];
+        if (cnt>=limit)
+            return qMin( i==0 ? qint64(0) : (qint64(1) << i) - 1, maxValue );
+    }
+    return maxValue;
+}
+
+QString Log2Histogram::toString() const {
+    return "n=" + QString::number(count) + " avg=" + QString::number(average()) +
+           " p50=" + QString::number(percentile(0.5)) + " p90=" + QString::number(percentile(0.9)) +
+           " p99=" + QString::number(percentile(0.99)) + " max=" + QString::number(maxValue);
+}
+
+QJsonObject Log2Histogram::toJson() const {
+    QJsonArray bk;
+    for (int i=0; i<BUCKETS; i++)
+        bk.append( double(buckets[i]) );
+
+    QJsonObject res;
+    res["count"] = double(count);
+    res["sum"] = double(sum);
+    res["max"] = double(maxValue);
+    res["p50"] = double(percentile(0.5));
+    res["p90"] = double(percentile(0.9));
+    res["p99"] = double(percentile(0.99));
+    res["log2buckets"] = bk;
+    return res;
+}
+
+void Mwc713TaskMetrics::taskQueued(int depth) {
+    QMutexLocker l(&metricsLock);
+    queueDepth.add(depth);
+}
+
+void Mwc713TaskMetrics::taskFinished(const QString & taskName, qint64 queueWaitMs, qint64 firstEventMs, qint64 readyMs, int lines, qint64 bytes) {
+    QMutexLocker l(&metricsLock);
+    TaskTypeMetrics & m = taskMetrics[taskName];
+    m.queueWaitMs.add(queueWaitMs);
+    if (firstEventMs>=0)
+        m.firstEventMs.add(firstEventMs);
+    m.readyMs.add(readyMs);
+    m.lines.add(lines);
+    m.bytes += quint64(bytes);
+}
+
+QString Mwc713TaskMetrics::getReport() const {
+    QMutexLocker l(&metricsLock);
+
+    QString report = "Queue depth: " + queueDepth.toString() + "\n";
+    for (auto it = taskMetrics.begin(); it != taskMetrics.end(); it++) {
+        const TaskTypeMetrics & m = it.value();
+        report += "\n" + it.key() + "\n" +
+                  "  queue wait, ms:  " + m.queueWaitMs.toString() + "\n" +
+                  "  first event, ms: " + m.firstEventMs.toString() + "\n" +
+                  "  ready, ms:       " + m.readyMs.toString() + "\n" +
+                  "  lines:           " + m.lines.toString() + "\n" +
+                  "  bytes parsed:    " + QString::number(m.bytes) + "\n";
+    }
+    return report;
+}
+
+QString Mwc713TaskMetrics::dump(const QString & fileName) const {
+    QJsonObject root;
+    {
+        QMutexLocker l(&metricsLock);
+        root["time"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+        root["queueDepth"] = queueDepth.toJson();
+
+        QJsonObject tasks;
+        for (auto it = taskMetrics.begin(); it != taskMetrics.end(); it++) {
+            const TaskTypeMetrics & m = it.value();
+            QJsonObject t;
+            t["queueWaitMs"] = m.queueWaitMs.toJson();
+            t["firstEventMs"] = m.firstEventMs.toJson();
+            t["readyMs"] = m.readyMs.toJson();
+            t["lines"] = m.lines.toJson();
+            t["bytes"] = double(m.bytes);
+            tasks[it.key()] = t;
+        }
+        root["tasks"] = tasks;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return "Unable to open file " + fileName + " for writing";
+
+    if (file.write( QJsonDocument(root).toJson() ) < 0)
+        return "Unable to write into the file " + fileName;
+
+    return "";
+}
+
+void Mwc713TaskMetrics::reset() {
+    QMutexLocker l(&metricsLock);
+    taskMetrics.clear();
+    queueDepth = Log2Histogram();
+}
+
+Mwc713TaskMetrics & getTaskMetrics() {
+    static Mwc713TaskMetrics metrics;
+    return metrics;
+}
+
+/////////////////////////////////////////////////////////////////
+// Mwc713TimeoutModel
+
+const static QString timeoutsFileName("mwc713timeouts.dat");
+
+const int64_t Mwc713TimeoutModel::MIN_TIMEOUT;
+
+int Mwc713TimeoutModel::calcWalletSizeClass(int outputsNum) {
+    // 0: <16 outputs, 1: <64, 2: <256, 3: <1024 ...
+    int sizeClass = 0;
+    for (int limit = 16; outputsNum >= limit && sizeClass < 8; limit *= 4)
+        sizeClass++;
+    return sizeClass;
+}
+
+QString Mwc713TimeoutModel::calcKey(const QString & walletId, const QString & taskName, int walletSizeClass) {
+    return walletId + "/" + taskName + "/" + QString::number(walletSizeClass);
+}
+
+int64_t Mwc713TimeoutModel::getTimeout(const QString & key, int64_t defaultTimeout, bool networkBound) {
+    QMutexLocker l(&modelLock);
+    if (!loaded)
+        load();
+
+    auto it = model.find( key );
+    if (it == model.end() || it->readyMs.size() < MIN_SAMPLES)
+        return defaultTimeout;
+
+    QVector<qint32> ms = it->readyMs;
+    auto p90 = ms.begin() + (ms.size() * 9) / 10;
+    std::nth_element(ms.begin(), p90, ms.end());
+    const int64_t p90ms = *p90;
+
+    // Enough room for a noise at fast commands, proportional for the slow ones
+    int64_t timeout = std::max( MIN_TIMEOUT, std::max( p90ms * 4, p90ms + MIN_TIMEOUT ) );
+    if (networkBound)
+        timeout = std::max( timeout, defaultTimeout/2 );
+    return timeout;
+}
+
+void Mwc713TimeoutModel::addExecution(const QString & key, int64_t readyMs) {
+    bool needSave = false;
+    {
+        QMutexLocker l(&modelLock);
+        if (!loaded)
+            load();
+
+        History & h = model[key];
+        const qint32 val = qint32(std::min(readyMs, int64_t(std::numeric_limits<qint32>::max())));
+        if (h.readyMs.size() < HISTORY_SIZE) {
+            h.readyMs.push_back(val);
+        }
+        else {
+            h.readyMs[h.next] = val;
+            h.next = (h.next + 1) % HISTORY_SIZE;
+        }
+
+        needSave = ++unsavedNum >= SAVE_PERIOD;
+    }
+
+    if (needSave)
+        save();
+}
+
+void Mwc713TimeoutModel::load() {
+    loaded = true;
+    model.clear();
+
+    QPair<bool,QString> dataPath = ioutils::getAppDataPath("context");
+    if (!dataPath.first)
+        return;
+
+    QFile file(dataPath.second + "/" + timeoutsFileName);
+    if ( !file.open(QIODevice::ReadOnly) )
+        return; // first run, no file exist
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_7);
+
+    // Version 2: keys include the wallet. Older models are dropped
+    int id = 0;
+    in >> id;
+    if (id != 0x5714)
+        return;
+
+    int sz = 0;
+    in >> sz;
+    for (int i=0; i<sz && in.status() == QDataStream::Ok; i++) {
+        QString key;
+        History h;
+        in >> key;
+        in >> h.readyMs;
+        in >> h.next;
+        if (h.readyMs.size() > HISTORY_SIZE || h.next<0 || h.next>=HISTORY_SIZE)
+            continue;
+        model.insert(key, h);
+    }
+
+    if (in.status() != QDataStream::Ok)
+        model.clear();
+}
+
+void Mwc713TimeoutModel::save() {
+    QMutexLocker l(&modelLock);
+    if (unsavedNum==0)
+        return;
+    unsavedNum = 0;
+
+    QPair<bool,QString> dataPath = ioutils::getAppDataPath("context");
+    if (!dataPath.first)
+        return;
+
+    // It is a cache, failure is not critical
+    QFile file(dataPath.second + "/" + timeoutsFileName);
+    if ( !file.open(QIODevice::WriteOnly | QIODevice::Truncate) )
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_7);
+
+    out << 0x5714;
+    out << model.size();
+    for (auto it = model.begin(); it != model.end(); it++) {
+        out << it.key();
+        out << it->readyMs;
+        out << it->next;
+    }
+}
+
+Mwc713TimeoutModel & getTimeoutModel() {
+    static Mwc713TimeoutModel timeouts;
+    return timeouts;
+}
+
+}
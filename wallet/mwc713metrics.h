@@ -0,0 +1,118 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC713METRICS_H
+#define MWC713METRICS_H
+
+#include <QString>
+#include <QMap>
+#include <QMutex>
+#include <QJsonObject>
+#include <QVector>
+
+namespace wallet {
+
+// Bounded histogram with power of 2 buckets. Bucket i has values in [2^(i-1), 2^i), bucket 0 is for 0.
+// Last bucket takes everything above.
+struct Log2Histogram {
+    enum { BUCKETS = 24 };
+
+    quint32 buckets[BUCKETS] = {};
+    quint64 count = 0;
+    quint64 sum = 0;
+    qint64  maxValue = 0;
+
+    void add(qint64 value);
+
+    // Upper bound of the bucket where percentile is. p in [0..1]. Return 0 for empty histogram
+    qint64 percentile(double p) const;
+    qint64 average() const { return count==0 ? 0 : qint64(sum/count); }
+
+    QString toString() const;
+    QJsonObject toJson() const;
+};
+
+// Metrics for a single task type
+struct TaskTypeMetrics {
+    Log2Histogram queueWaitMs;  // time from addTask to start
+    Log2Histogram firstEventMs; // time from start to first event from mwc713
+    Log2Histogram readyMs;      // time from start to ready event
+    Log2Histogram lines;        // S_LINE events per task
+    quint64 bytes = 0;          // total size of parsed events messages
+};
+
+// Latency and queue depth metrics for mwc713 tasks. Collected for the whole app session.
+// Thread safe, the report can be requested from any thread.
+class Mwc713TaskMetrics {
+public:
+    // Called when task is added. queueDepth - number of tasks in the queue including this one
+    void taskQueued(int queueDepth);
+    // Called when task was executed. firstEventMs < 0 if there was no events
+    void taskFinished(const QString & taskName, qint64 queueWaitMs, qint64 firstEventMs, qint64 readyMs, int lines, qint64 bytes);
+
+    // Human readable report for diagnostics
+    QString getReport() const;
+    // Dump into the file as json. Return empty string on success, otherwise error message
+    QString dump(const QString & fileName) const;
+
+    void reset();
+private:
+    mutable QMutex metricsLock;
+    QMap<QString, TaskTypeMetrics> taskMetrics; // Task name => metrics. Number of task types is limited
+    Log2Histogram queueDepth;
+};
+
+// Metrics for all mwc713 instances of this session
+Mwc713TaskMetrics & getTaskMetrics();
+
+// Timeouts for mwc713 tasks learned from the recent executions. The key is the wallet (network and data path),
+// task type and size of the account, so big accounts get more time while stuck commands at small ones are detected faster.
+// Model is stored at the app data and survive restarts.
+class Mwc713TimeoutModel {
+public:
+    enum { HISTORY_SIZE = 32, MIN_SAMPLES = 5, SAVE_PERIOD = 20 };
+    const static int64_t MIN_TIMEOUT = 3000;
+
+    // Return timeout in ms. defaultTimeout is used until there are enough executions.
+    // Network bound tasks depend on the node and peers, few fast runs don't predict the next one.
+    // Their timeout stays at least half of the default.
+    int64_t getTimeout(const QString & key, int64_t defaultTimeout, bool networkBound);
+    // Register execution time of the finished task. For the task that hit the timeout it is the time when it was abandoned.
+    void addExecution(const QString & key, int64_t readyMs);
+
+    // Save the model if it was changed
+    void save();
+
+    // Wallet size class from the number of outputs
+    static int calcWalletSizeClass(int outputsNum);
+    // walletId - network and data path of the wallet
+    static QString calcKey(const QString & walletId, const QString & taskName, int walletSizeClass);
+private:
+    void load();
+
+    struct History {
+        QVector<qint32> readyMs; // ring buffer, up to HISTORY_SIZE
+        int next = 0;
+    };
+
+    QMutex modelLock;
+    bool loaded = false;
+    int unsavedNum = 0;
+    QMap<QString, History> model; // key from calcKey => recent executions
+};
+
+Mwc713TimeoutModel & getTimeoutModel();
+
+}
+
+#endif // MWC713METRICS_H
@@ -0,0 +1,233 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mwc713reader.h"
+#include "../tries/mwc713inputparser.h"
+#include "../util/Log.h"
+#include "../util/stringutils.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace wallet {
+
+// mwc713 prompt that can be located at the beginning of any line
+static const QByteArray MWC713_PROMPT("wallet713>");
+
+// Length of the data that has only complete UTF-8 sequences
+static int completeUtf8Length(const char * data, int len) {
+    // Looking for the last lead byte, at most 4 bytes back
+    for (int back = 1; back <= std::min(4, len); back++) {
+        const uchar c = uchar(data[len-back]);
+        if ( (c & 0xC0) == 0x80 )
+            continue; // continuation byte
+
+        int seqLen = 1;
+        if ( (c & 0xE0) == 0xC0 ) seqLen = 2;
+        else if ( (c & 0xF0) == 0xE0 ) seqLen = 3;
+        else if ( (c & 0xF8) == 0xF0 ) seqLen = 4;
+        return back < seqLen ? len-back : len;
+    }
+    return len;
+}
+
+const QString & Mwc713OutputSplitter::processChunk(const QByteArray & data) {
+    parserInput.resize(0);
+    rawLines.resize(0);
+    filteredLines.resize(0);
+
+    const char * ptr = data.constData();
+    const int len = data.size();
+    for (int i=0; i<len; i++) {
+        const char d = ptr[i];
+        // Escape sequences like '\e[1;32m' are skipped
+        if (d==27)
+            inEsc = true;
+        if (inEsc) {
+            if (d=='m')
+                inEsc = false;
+            continue;
+        }
+
+        if (d=='\n' || d=='\r') {
+            if (!lineBuf.isEmpty())
+                flushLine(true);
+            midLine = false;
+            // Line breaks are collapsed into a single one
+            if (!lastIsNewLine) {
+                parserInput += QLatin1Char('\n');
+                lastIsNewLine = true;
+            }
+            continue;
+        }
+
+        if ( uchar(d) >= 0x80 )
+            lineIsAscii = false;
+        lineBuf.append(d);
+    }
+
+    // Parser need the partial line now, the prompt doesn't have a new line.
+    // The exception is a line start that still can be 'wallet713>'
+    if ( !lineBuf.isEmpty() && (midLine || !MWC713_PROMPT.startsWith(lineBuf)) )
+        flushLine(false);
+
+    return parserInput;
+}
+
+void Mwc713OutputSplitter::flushLine(bool complete) {
+    int len = lineBuf.size();
+    if (!complete && !lineIsAscii)
+        len = completeUtf8Length(lineBuf.constData(), len);
+    if (len==0)
+        return;
+
+    QString line = lineIsAscii ? QString::fromLatin1(lineBuf.constData(), len) : QString::fromUtf8(lineBuf.constData(), len);
+    rawLines.push_back(line);
+
+    if (!midLine && lineBuf.startsWith(MWC713_PROMPT))
+        line = line.mid(MWC713_PROMPT.size()).trimmed();
+
+    parserInput += line;
+    lastIsNewLine = false;
+    if (!line.isEmpty())
+        filteredLines.push_back(line);
+
+    // Incomplete UTF-8 tail stays for the next chunk
+    lineBuf.remove(0, len);
+    lineIsAscii = lineBuf.isEmpty();
+    midLine = !complete;
+}
+
+Mwc713OutputWorker::Mwc713OutputWorker(tries::Mwc713InputParser * _inputParser) :
+    inputParser(_inputParser)
+{
+    head = tail = new Chunk();
+}
+
+Mwc713OutputWorker::~Mwc713OutputWorker() {
+    while (head) {
+        Chunk * next = head->next.loadAcquire();
+        delete head;
+        head = next;
+    }
+    tail = nullptr;
+
+    delete inputParser;
+    inputParser = nullptr;
+}
+
+void Mwc713OutputWorker::pushOutput(const QByteArray & data) {
+    Chunk * chunk = new Chunk();
+    chunk->rawOutput = data;
+    chunk->isRaw = true;
+    push(chunk);
+}
+
+void Mwc713OutputWorker::pushParserInput(const QString & input) {
+    Chunk * chunk = new Chunk();
+    chunk->parserInput = input;
+    chunk->isRaw = false;
+    push(chunk);
+}
+
+void Mwc713OutputWorker::push(Chunk * chunk) {
+    tail->next.storeRelease(chunk);
+    tail = chunk;
+
+    // Waking up the consumer only if it is not scheduled yet
+    if (wakeScheduled.testAndSetOrdered(0, 1))
+        QMetaObject::invokeMethod(this, "processPending", Qt::QueuedConnection);
+}
+
+void Mwc713OutputWorker::processPending() {
+    // Reset first, everything that pushed after will schedule a new call
+    wakeScheduled.storeRelease(0);
+
+    while (true) {
+        Chunk * next = head->next.loadAcquire();
+        if (next == nullptr)
+            break;
+
+        // next become a new dummy node
+        delete head;
+        head = next;
+
+        if (next->isRaw) {
+            QByteArray data;
+            data.swap(next->rawOutput);
+            processOutput(data);
+        }
+        else {
+            QString input;
+            input.swap(next->parserInput);
+            inputParser->processInput(input);
+        }
+    }
+}
+
+void Mwc713OutputWorker::processOutput(const QByteArray & data) {
+    const QString & parserInput = splitter.processChunk(data);
+    qDebug() << "Get output:" << parserInput;
+    logger::logMwc713outLines( splitter.getRawLines() );
+
+    {
+        QMutexLocker l(&linesLock);
+        for (const auto & ln : splitter.getFilteredLines()) {
+            if (outputsLines.size()>outputsLinesBufferSize)
+                outputsLines.pop_front();
+            outputsLines.push_back(ln);
+        }
+    }
+
+    if (!parserInput.isEmpty())
+        inputParser->processInput(parserInput);
+}
+
+QList<QString> Mwc713OutputWorker::getOutputLines() const {
+    QMutexLocker l(&linesLock);
+    return outputsLines;
+}
+
+void Mwc713OutputWorker::appendOutputLines(const QString & str) {
+    QMutexLocker l(&linesLock);
+    util::updateEventList(outputsLines, str);
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//    Mwc713OutputReader
+
+Mwc713OutputReader::Mwc713OutputReader(tries::Mwc713InputParser * inputParser) {
+    worker = new Mwc713OutputWorker(inputParser);
+    inputParser->moveToThread(&thread);
+    worker->moveToThread(&thread);
+    thread.setObjectName("mwc713 reader");
+    thread.start();
+}
+
+Mwc713OutputReader::~Mwc713OutputReader() {
+    thread.quit();
+    thread.wait();
+
+    // Thread is finished, it is safe to use the worker from here. Last output usually has
+    // the exit reason, so the data that wasn't processed yet goes to the logs and parser.
+    worker->processPending();
+    delete worker;
+    worker = nullptr;
+}
+
+void Mwc713OutputReader::waitForProcessed() {
+    // Queued wake up calls are ahead of this one, so all pushed data will be processed
+    QMetaObject::invokeMethod(worker, "processPending", Qt::BlockingQueuedConnection);
+}
+
+}
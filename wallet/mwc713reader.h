@@ -0,0 +1,143 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC713READER_H
+#define MWC713READER_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+#include <QString>
+
+namespace tries {
+    class Mwc713InputParser;
+}
+
+namespace wallet {
+
+// Streaming splitter for mwc713 stdout. In a single pass over the bytes it strips ANSI escape
+// sequences and 'wallet713>' prompt, collapses line breaks and builds the parser input.
+// Lines and escape sequences that are split between the chunks are handled. Buffers are reused.
+class Mwc713OutputSplitter {
+public:
+    Mwc713OutputSplitter() = default;
+
+    // Process next chunk of stdout. Return the parser input, valid until the next call.
+    const QString & processChunk(const QByteArray & data);
+
+    // Lines or their parts from the last chunk, before prompt stripping. For logging.
+    const QVector<QString> & getRawLines() const {return rawLines;}
+    // Not empty lines or their parts from the last chunk, after prompt stripping.
+    const QVector<QString> & getFilteredLines() const {return filteredLines;}
+
+private:
+    // Move line data into the outputs. Partial line keeps incomplete UTF-8 tail at the buffer.
+    void flushLine(bool complete);
+
+private:
+    bool inEsc = false;      // Inside escape sequence
+    bool midLine = false;    // Line beginning was already flushed
+    bool lastIsNewLine = false; // Parser input ends with a new line
+    bool lineIsAscii = true; // lineBuf has only ASCII symbols
+    QByteArray lineBuf;      // Current line data
+    QString parserInput;
+    QVector<QString> rawLines;
+    QVector<QString> filteredLines;
+};
+
+// Worker that runs mwc713 stdout pipeline: filter -> log -> parse.
+// It lives at its own thread. Mwc713InputParser emits events from that thread, they are
+// delivered to Mwc713EventManager by queued connection in the same order as before.
+// GUI thread hands raw bytes over through lock free single producer/single consumer queue.
+class Mwc713OutputWorker : public QObject {
+    Q_OBJECT
+public:
+    // Take ownership of the parser
+    Mwc713OutputWorker(tries::Mwc713InputParser * inputParser);
+    virtual ~Mwc713OutputWorker() override;
+
+    Mwc713OutputWorker(const Mwc713OutputWorker & ) = delete;
+    Mwc713OutputWorker & operator=(const Mwc713OutputWorker & ) = delete;
+
+    // Producer side, must be called from a single thread (GUI)
+    // Raw mwc713 stdout
+    void pushOutput(const QByteArray & data);
+    // Data that goes to the parser as it is
+    void pushParserInput(const QString & input);
+
+    // Last few output lines, thread safe
+    QList<QString> getOutputLines() const;
+    void appendOutputLines(const QString & str);
+
+public slots:
+    // Consumer side, worker thread. Process everything that was pushed
+    void processPending();
+
+private:
+    struct Chunk {
+        QByteArray rawOutput;   // mwc713 stdout
+        QString    parserInput; // Input for the parser as it is
+        bool       isRaw = true;
+        QAtomicPointer<Chunk> next;
+    };
+
+    void push(Chunk * chunk);
+    void processOutput(const QByteArray & data);
+
+private:
+    tries::Mwc713InputParser * inputParser = nullptr; // owned
+    Mwc713OutputSplitter splitter;
+    Chunk * head = nullptr; // Consumer side, dummy node
+    Chunk * tail = nullptr; // Producer side
+    QAtomicInt wakeScheduled; // 1 if processPending is queued and not started yet
+
+    const int outputsLinesBufferSize = 15;
+    mutable QMutex linesLock;
+    QList<QString> outputsLines; // Last few output lines. Will print in case of the crash
+};
+
+// Owner of the worker and its thread. Created for every mwc713 process run.
+class Mwc713OutputReader {
+public:
+    // Take ownership of the parser, it will be moved to the worker thread.
+    // Note: parser signals must be connected before.
+    Mwc713OutputReader(tries::Mwc713InputParser * inputParser);
+    // Stop the thread. Data that wasn't processed yet is processed at the caller thread
+    ~Mwc713OutputReader();
+
+    Mwc713OutputReader(const Mwc713OutputReader & ) = delete;
+    Mwc713OutputReader & operator=(const Mwc713OutputReader & ) = delete;
+
+    void pushOutput(const QByteArray & data) { worker->pushOutput(data); }
+    void pushParserInput(const QString & input) { worker->pushParserInput(input); }
+
+    // Block until everything that was pushed is parsed
+    void waitForProcessed();
+
+    QList<QString> getOutputLines() const { return worker->getOutputLines(); }
+    void appendOutputLines(const QString & str) { worker->appendOutputLines(str); }
+
+private:
+    QThread thread;
+    Mwc713OutputWorker * worker = nullptr;
+};
+
+}
+
+#endif // MWC713READER_H
@@ -38,6 +38,18 @@ public:
 
     virtual void onStarted() {}
 
+    // Account that mwc713 will have active after this task. Empty if task doesn't switch accounts.
+    virtual QString getSwitchAccount() const {return "";}
+    // True if after this task active mwc713 account is unknown
+    virtual bool resetsActiveAccount() const {return false;}
+    // True if execution time depends on the node or peers, not only on the wallet data
+    virtual bool isNetworkBound() const {return false;}
+
+    // Called for every event while the task is running, before the ready event.
+    // Streaming tasks can process the data as it comes, in this case event will not be passed into processTask.
+    // Return true if event was consumed.
+    virtual bool consumeEvent(const WEvent & event) { Q_UNUSED(event); return false; }
+
     // Will be called from 'Ready' for normal tasks
     // Or in order as events coming for filtering tasks
     // Return true if data was processed. In this case processed evenets will be dropped
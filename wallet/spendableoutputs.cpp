@@ -0,0 +1,101 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "spendableoutputs.h"
+#include "../core/appcontext.h"
+#include "../core/global.h"
+#include <algorithm>
+
+namespace wallet {
+
+static int64_t lastRevision = 0;
+
+void SpendableOutputs::setOutputs(QVector<WalletOutput> _outputs) {
+    revision = ++lastRevision;
+    outputs = _outputs;
+    std::stable_sort( outputs.begin(), outputs.end(), [](const WalletOutput & a, const WalletOutput & b) {
+        return a.valueNano < b.valueNano;
+    });
+
+    prefixSums.resize(outputs.size()+1);
+    prefixSums[0] = 0;
+    for (int i=0; i<outputs.size(); i++)
+        prefixSums[i+1] = prefixSums[i] + outputs[i].valueNano;
+}
+
+int SpendableOutputs::countToCover(int64_t amount) const {
+    if (amount <= 0)
+        return 0;
+    if (amount > getTotal())
+        return -1;
+    // First prefix that is >= amount
+    return int( std::lower_bound( prefixSums.begin(), prefixSums.end(), amount ) - prefixSums.begin() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SpendableOutputsIndex
+
+const SpendableOutputs & SpendableOutputsIndex::get(const QString & account, const QVector<WalletOutput> & outputs, const core::AppContext * appContext) {
+    const int confirmNumber = appContext->getSendCoinsParams().inputConfirmationNumber;
+    const bool lockEnabled = appContext->isLockOutputEnabled();
+
+    AccountIndex & idx = index[account];
+    if ( idx.tipHeight == tipHeight && idx.confirmNumber == confirmNumber && idx.lockEnabled == lockEnabled )
+        return idx.spendable;
+
+    // Outputs confirmations are from the moment when they was requested
+    const int64_t outHeight = outputsHeight.value(account, 0);
+    const int64_t confirmsDelta = (outHeight>0 && tipHeight>outHeight) ? tipHeight - outHeight : 0;
+
+    QVector<WalletOutput> spendable;
+    for ( const WalletOutput & o : outputs) {
+        if ( !o.isUnspent() ) // Interested only in Unspent outputs
+            continue;
+        const int64_t confirms = o.numOfConfirms + confirmsDelta;
+        // Skip mined that can't spend
+        if (o.coinbase && confirms<=mwc::COIN_BASE_CONFIRM_NUMBER )
+            continue;
+        if (!o.coinbase && confirms < confirmNumber)
+            continue;
+        // ensure outputs locked by Qt Wallet are not used
+        if (lockEnabled && appContext->isLockedOutputs(o.outputCommitment))
+            continue;
+        spendable.push_back(o);
+    }
+
+    idx.spendable.setOutputs(spendable);
+    idx.tipHeight = tipHeight;
+    idx.confirmNumber = confirmNumber;
+    idx.lockEnabled = lockEnabled;
+    return idx.spendable;
+}
+
+void SpendableOutputsIndex::setOutputs(const QString & account, int64_t height) {
+    outputsHeight.insert(account, height);
+    invalidate(account);
+}
+
+void SpendableOutputsIndex::setTipHeight(int64_t height) {
+    // Rebuild will be done on request, it is cheap to keep it lazy
+    tipHeight = height;
+}
+
+void SpendableOutputsIndex::renameAccount(const QString & oldName, const QString & newName) {
+    if (outputsHeight.contains(oldName))
+        outputsHeight.insert(newName, outputsHeight.take(oldName));
+    invalidate(oldName);
+    invalidate(newName);
+}
+
+}
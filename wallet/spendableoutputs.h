@@ -0,0 +1,87 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC_QT_WALLET_SPENDABLEOUTPUTS_H
+#define MWC_QT_WALLET_SPENDABLEOUTPUTS_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include "wallet.h"
+
+namespace core {
+class AppContext;
+}
+
+namespace wallet {
+
+// Outputs that can be spent, sorted by value (smaller first) with prefix sums.
+// Selection of the smallest outputs for amount is O(log n)
+class SpendableOutputs {
+public:
+    // Set outputs, they will be sorted by value
+    void setOutputs(QVector<WalletOutput> outputs);
+
+    const QVector<WalletOutput> & getOutputs() const {return outputs;}
+    int size() const {return outputs.size();}
+    bool isEmpty() const {return outputs.isEmpty();}
+
+    // Total value of all outputs
+    int64_t getTotal() const {return prefixSums.last();}
+    // Total value of 'n' smallest outputs
+    int64_t getPrefixSum(int n) const {return prefixSums[n];}
+
+    // Number of smallest outputs that cover the amount. -1 if amount is larger than total
+    int countToCover(int64_t amount) const;
+
+    // Unique for every setOutputs call. Use it to cache the data that is calculated from the outputs
+    int64_t getRevision() const {return revision;}
+
+private:
+    int64_t revision = 0;
+    QVector<WalletOutput> outputs;
+    QVector<int64_t> prefixSums = QVector<int64_t>{0}; // prefixSums[i] - total of first i outputs
+};
+
+// Spendable outputs index for all accounts. Index is rebuilt on request if
+// outputs, locks, send parameters or tip height was changed.
+class SpendableOutputsIndex {
+public:
+    // Get spendable outputs for the account. 'outputs' - all known outputs for this account
+    const SpendableOutputs & get(const QString & account, const QVector<WalletOutput> & outputs, const core::AppContext * appContext);
+
+    // New outputs data. height - the height when the outputs was requested
+    void setOutputs(const QString & account, int64_t height);
+    // New node tip. Confirmations number is changing with it
+    void setTipHeight(int64_t height);
+
+    void invalidate(const QString & account) {index.remove(account);}
+    void invalidateAll() {index.clear();}
+    void renameAccount(const QString & oldName, const QString & newName);
+
+private:
+    struct AccountIndex {
+        SpendableOutputs spendable;
+        int64_t tipHeight = -1;
+        int     confirmNumber = -1;
+        bool    lockEnabled = false;
+    };
+
+    QMap<QString, AccountIndex> index;
+    QMap<QString, int64_t> outputsHeight; // Height when outputs was requested
+    int64_t tipHeight = 0;
+};
+
+}
+
+#endif //MWC_QT_WALLET_SPENDABLEOUTPUTS_H
@@ -256,6 +256,13 @@ bool TaskAccountProgress::processTask(const QVector<WEvent> &events) {
     return true;
 }
 
+// ---------------------- TaskAccountListPartial -------------------------
+bool TaskAccountListPartial::processTask(const QVector<WEvent> &events) {
+    Q_UNUSED(events);
+    wallet713->updatePartialAccountList( accounts );
+    return true;
+}
+
 // ---------------------- TaskAccountListFinal -------------------------
 bool TaskAccountListFinal::processTask(const QVector<WEvent> &events) {
     Q_UNUSED(events);
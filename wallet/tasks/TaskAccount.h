@@ -72,6 +72,8 @@ public:
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+
+    virtual QString getSwitchAccount() const override {return switchAccountName;}
 private:
     QString switchAccountName;
 };
@@ -93,6 +95,9 @@ public:
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+
+    // Renamed account might be the active one
+    virtual bool resetsActiveAccount() const override {return true;}
 private:
     QString oldName;
     QString newName;
@@ -129,6 +134,19 @@ private:
     int total;
 };
 
+// Just a callback, not a real task. Starts info collection for some accounts, the rest keep the current data
+class TaskAccountListPartial : public Mwc713Task {
+public:
+    TaskAccountListPartial( MWC713 * _wallet713, const QVector<QString> & _accounts ) :
+            Mwc713Task("TaskAccountListPartial", "", _wallet713,""), accounts(_accounts) {}
+
+    virtual bool processTask(const QVector<WEvent> &events) override;
+
+    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+private:
+    QVector<QString> accounts;
+};
+
 // Just a callback, not a real task
 class TaskAccountListFinal : public Mwc713Task {
 public:
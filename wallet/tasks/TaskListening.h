@@ -51,6 +51,7 @@ public:
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 private:
     QString calcCommand(bool startMq, bool startKeybase, bool startTor) const;
 
@@ -72,6 +73,7 @@ public:
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 private:
     QString calcCommand(bool stopMq, bool stopKeybase, bool stopTor) const;
 };
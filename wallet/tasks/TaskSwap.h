@@ -52,6 +52,7 @@ public:
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 };
 
 // Delete single trade.
@@ -191,6 +192,7 @@ public:
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 private:
     QString swapId;
 };
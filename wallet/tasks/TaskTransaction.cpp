@@ -62,6 +62,13 @@ static QVector<QString> parseDataLine( const QString & str, const QVector<int> &
 
 // ------------------------------------ TaskOutputs -------------------------------------------
 
+// Numeric output field. Empty or not a number values are not defined, -1
+static int64_t parseOutputNumber( const QString & str ) {
+    bool ok = false;
+    int64_t res = str.toLongLong(&ok);
+    return ok ? res : -1;
+}
+
 WalletOutput parseOutputLine( QString str, const QVector<int> & outputLayout) {
 
     WalletOutput res; // invalid until data is set
@@ -91,12 +98,12 @@ WalletOutput parseOutputLine( QString str, const QVector<int> & outputLayout) {
         return res;
 
     res.setData(strOutputCommitment,
-                   strMmrIndex,
-                   strBlockHeight,
-            strLockedUntil,
-            strStatus,
+            parseOutputNumber(strMmrIndex),
+            parseOutputNumber(strBlockHeight),
+            parseOutputNumber(strLockedUntil),
+            WalletOutput::str2status(strStatus),
             strCoinbase != "false",
-            strConfirms,
+            qMax( int64_t(0), parseOutputNumber(strConfirms) ),
             mwcOne.second,
             tx);
 
@@ -104,101 +111,91 @@ WalletOutput parseOutputLine( QString str, const QVector<int> & outputLayout) {
 }
 
 
-static void parseOutputs(const QVector<WEvent> & events, // in
-                              QString & account, // out
-                              int64_t & height,  // out
-                              QVector<WalletOutput> & outputVector) // out
-{
-    int curEvt = 0;
-
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_OUTPUT_LOG ) {
-            QStringList l = events[curEvt].message.split('|');
+// Process events for 'outputs' output one by one.
+bool OutputsStreamParser::processEvent(const WEvent & evt) {
+    if (evt.event == WALLET_EVENTS::S_OUTPUT_LOG) {
+        if (stage == STAGE::WAIT_LOG) {
+            QStringList l = evt.message.split('|');
             Q_ASSERT(l.size()==2);
             account = l[0];
             height = l[1].toInt();
-            break;
+            stage = STAGE::HEADER;
         }
+        return true;
     }
 
-    // positions for the columns. Note, the columns and the order are hardcoded and come from mwc713 data!!!
+    if (evt.event != WALLET_EVENTS::S_LINE)
+        return false;
 
-    QVector<int> outputLayout;
+    const QString & str = evt.message;
 
-    // Continue with transaction output
-    // Search for Header first
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto & str = events[curEvt].message;
+    switch (stage) {
+        case STAGE::HEADER:
+            // positions for the columns. Note, the columns and the order are hardcoded and come from mwc713 data!!!
             if ( str.contains("Output Commitment") && str.contains("Block Height") ) {
-
                 outputLayout = parseHeadersLine( str, {"Output Commitment", "MMR Index", "Block Height",
                                                        "Locked Until", "Status", "Coinbase?", "# Confirms", "Value", "Tx"} );
-
-                if ( outputLayout.size()>0 ) {
-                    curEvt++;
-                    break;
-                }
-                Q_ASSERT(false); // There is a small chance, but it is really not likely it is ok
+                if ( outputLayout.size()>0 )
+                    stage = STAGE::HEADER_END;
+                else
+                    Q_ASSERT(false); // There is a small chance, but it is really not likely it is ok
             }
-        }
-    }
+            break;
+        case STAGE::HEADER_END:
+            if (str.startsWith("=============="))
+                stage = STAGE::DATA;
+            break;
+        case STAGE::DATA: {
+            if (str.startsWith("--------------------"))
+                break;
 
-    // Skip header
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE) {
-            auto &str = events[curEvt].message;
             if (str.startsWith("==============")) {
-                curEvt++; // skipping this
+                stage = STAGE::DONE; // multiple data types case, nned to handle without surprises
                 break;
             }
-        }
-    }
-
-    // Processing transactions
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto &str = events[curEvt].message;
-
-            if (str.startsWith("--------------------"))
-                continue;
-
-            if (str.startsWith("=============="))
-                break; // multiple data types case, nned to handle without surprises
 
             // Expected to be a normal line
             WalletOutput output = parseOutputLine(str, outputLayout);
             if ( output.isValid() ) {
-                outputVector.push_back(output);
+                outputs.push_back(output);
             }
+            break;
         }
+        default:
+            break;
     }
+    return true;
 }
 
-bool TaskOutputs::processTask(const QVector<WEvent> & events) {
-    // We are processing transactions outptu mostly as a raw data
+static void parseOutputs(const QVector<WEvent> & events, // in
+                              QString & account, // out
+                              int64_t & height,  // out
+                              QVector<WalletOutput> & outputVector) // out
+{
+    OutputsStreamParser parser;
+    for (const WEvent & evt : events)
+        parser.processEvent(evt);
 
-    QString account;
-    int64_t  height = -1;
-    QVector< WalletOutput > outputResult;
+    if (parser.hasLog()) {
+        account = parser.account;
+        height = parser.height;
+    }
+    outputVector += parser.outputs;
+}
 
-    parseOutputs(events, // in
-           account, height, outputResult); // out
+bool TaskOutputs::processTask(const QVector<WEvent> & events) {
+    // We are processing transactions outptu mostly as a raw data
 
-    wallet713->setOutputs(account, showSpent, height, outputResult );
+    // Lines was already parsed as they come
+    Q_UNUSED(events)
+    wallet713->setOutputs(parser.account, showSpent, parser.height, parser.outputs );
     return true;
 }
 
 bool TaskOutputsForAccount::processTask(const QVector<WEvent> & events) {
 
-    QString account;
-    int64_t  height = -1;
-    QVector< WalletOutput > outputResult;
-
-    parseOutputs( events, // in
-                     account, height, outputResult );
-
-    wallet713->setWalletOutputs( account, outputResult);
+    Q_UNUSED(events)
+    wallet713->setWalletOutputs( parser.account, parser.height, parser.outputs);
     return true;
 }
 
@@ -285,81 +282,53 @@ static WalletTransaction parseTransactionLine( const QString & str, const QVecto
     return res;
 }
 
-// local utility function that parse transactions output
-static void parseTransactions(const QVector<WEvent> & events, // in
-                                    QString & account, // out
-                                    int64_t & height,  // out
-                                    QVector<WalletTransaction> & trVector) // out
-{
-    // We are processing transactions mostly as a raw data
-    int curEvt = 0;
-
-    account = "";
-    height = -1;
-
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_TRANSACTION_LOG ) {
-            QStringList l = events[curEvt].message.split('|');
+// Process events for 'txs' output one by one.
+bool TransactionsStreamParser::processEvent(const WEvent & evt) {
+    if (evt.event == WALLET_EVENTS::S_TRANSACTION_LOG) {
+        if (stage == STAGE::WAIT_LOG) {
+            QStringList l = evt.message.split('|');
             Q_ASSERT(l.size()==2);
             account = l[0];
             height = l[1].toInt();
-            break;
+            stage = STAGE::HEADER;
         }
+        return true;
     }
 
-    // positions for the columns. Note, the columns and the order are hardcoded and come from mwc713 data!!!
+    if (evt.event != WALLET_EVENTS::S_LINE)
+        return false;
 
-    QVector<int> txLayout;
+    const QString & str = evt.message;
 
-    // Continue with transaction output
-    // Search for Header first
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto & str = events[curEvt].message;
+    switch (stage) {
+        case STAGE::HEADER:
+            // positions for the columns. Note, the columns and the order are hardcoded and come from mwc713 data!!!
             if ( str.contains("Creation Time") && str.contains("Confirmed?") ) {
-
                 txLayout = parseHeadersLine( str, {"Id", "Type", "Shared Transaction Id", "Address", "Creation Time",
                                "TTL Cutoff Height", "Confirmed?", "Height", "Confirmation Time",  "Num.",  "Num.", "Amount", "Amount", "Fee", "Net", "Payment", "Kernel", "Tx"} );
-
-                if ( txLayout.size()>0 ) {
-                    curEvt++;
-                    break;
-                }
-                Q_ASSERT(false); // There is a small chance, but it is really not likely it is ok
+                if ( txLayout.size()>0 )
+                    stage = STAGE::HEADER_END;
+                else
+                    Q_ASSERT(false); // There is a small chance, but it is really not likely it is ok
             }
-        }
-    }
+            break;
+        case STAGE::HEADER_END:
+            if (str.startsWith("=============="))
+                stage = STAGE::DATA;
+            break;
+        case STAGE::DATA: {
+            if (str.startsWith("--------------------"))
+                break;
 
-    // Skip header
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE) {
-            auto &str = events[curEvt].message;
             if (str.startsWith("==============")) {
-                curEvt++; // skipping this
+                stage = STAGE::DONE; // multiple data types case, nned to handle without surprises
                 break;
             }
-        }
-    }
-
-    QMap<int64_t, WalletTransaction > transactions;
-
-    // Processing transactions
-    int64_t lastTransId = -1;
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto &str = events[curEvt].message;
-
-            if (str.startsWith("--------------------"))
-                continue;
-
-            if (str.startsWith("=============="))
-                break; // multiple data types case, nned to handle without surprises
-
 
             // mwc713 has a special line for 'cancelled'
             if (str.contains("- Cancelled")) {
                 transactions[lastTransId].cancelled();
-                continue;
+                break;
             }
 
             // Expected to be a normal line
@@ -368,24 +337,41 @@ static void parseTransactions(const QVector<WEvent> & events, // in
                 lastTransId = trans.txIdx;
                 transactions[trans.txIdx] = trans;
             }
+            break;
         }
+        default:
+            break;
     }
+    return true;
+}
 
-    trVector.clear();
-    for ( WalletTransaction & trItem : transactions )
+QVector<WalletTransaction> TransactionsStreamParser::getTransactions() const {
+    QVector<WalletTransaction> trVector;
+    trVector.reserve(transactions.size());
+    for ( const WalletTransaction & trItem : transactions )
         trVector.push_back( trItem );
+    return trVector;
 }
 
-bool TaskTransactions::processTask(const QVector<WEvent> & events) {
-
-    QString account;
-    int64_t height = -1;
-    QVector<WalletTransaction> trVector;
+// local utility function that parse transactions output
+static void parseTransactions(const QVector<WEvent> & events, // in
+                                    QString & account, // out
+                                    int64_t & height,  // out
+                                    QVector<WalletTransaction> & trVector) // out
+{
+    TransactionsStreamParser parser;
+    for (const WEvent & evt : events)
+        parser.processEvent(evt);
 
-    parseTransactions(events, // in
-                           account, height, trVector); // out
+    account = parser.account;
+    height = parser.height;
+    trVector = parser.getTransactions();
+}
 
-    wallet713->setTransactions( account, height, trVector );
+bool TaskTransactions::processTask(const QVector<WEvent> & events) {
+    // Lines was already parsed as they come
+    Q_UNUSED(events)
+    wallet713->setTransactions( parser.account, parser.height, parser.getTransactions() );
     return true;
 }
 
@@ -496,25 +482,19 @@ bool TaskTransactionsById::processTask(const QVector<WEvent> & events) {
 // Just a callback, not a real task
 bool TaskAllTransactionsStart::processTask(const QVector<WEvent> &events) {
     Q_UNUSED(events)
-    wallet713->processAllTransactionsStart();
+    wallet713->processAllTransactionsStart(streamId, accountsNum);
     return true;
 }
 
 bool TaskAllTransactionsEnd::processTask(const QVector<WEvent> &events) {
     Q_UNUSED(events)
-    wallet713->processAllTransactionsEnd();
+    wallet713->processAllTransactionsEnd(streamId);
     return true;
 }
 
 bool TaskAllTransactions::processTask(const QVector<WEvent> & events) {
-    QString account;
-    int64_t height = -1;
-    QVector<WalletTransaction> trVector;
-
-    parseTransactions(events, // in
-                    account, height, trVector); // out
-
-    wallet713->processAllTransactionsAppend( trVector );
+    Q_UNUSED(events)
+    wallet713->processAllTransactionsAppend( parser.account, parser.getTransactions() );
 
     return true;
 }
@@ -17,6 +17,8 @@
 
 #include "../mwc713task.h"
 #include "../../util/stringutils.h"
+#include "../wallet.h"
+#include <QMap>
 
 namespace core {
 class HodlStatus;
@@ -24,6 +26,40 @@ class HodlStatus;
 
 namespace wallet {
 
+// Incremental parser for the 'outputs' command result. Events are processed as they come,
+// so the output lines are not stored.
+class OutputsStreamParser {
+public:
+    // Return true if event belong to the outputs data
+    bool processEvent(const WEvent & evt);
+    bool hasLog() const {return stage != STAGE::WAIT_LOG;}
+
+    QString account;
+    int64_t height = -1;
+    QVector<WalletOutput> outputs;
+private:
+    enum class STAGE { WAIT_LOG, HEADER, HEADER_END, DATA, DONE };
+    STAGE stage = STAGE::WAIT_LOG;
+    QVector<int> outputLayout; // positions for the columns
+};
+
+// Incremental parser for the 'txs' command result.
+class TransactionsStreamParser {
+public:
+    // Return true if event belong to the transactions data
+    bool processEvent(const WEvent & evt);
+    // Transactions sorted by id
+    QVector<WalletTransaction> getTransactions() const;
+
+    QString account;
+    int64_t height = -1;
+private:
+    enum class STAGE { WAIT_LOG, HEADER, HEADER_END, DATA, DONE };
+    STAGE stage = STAGE::WAIT_LOG;
+    QVector<int> txLayout; // positions for the columns
+    QMap<int64_t, WalletTransaction> transactions;
+    int64_t lastTransId = -1;
+};
 
 class TaskOutputs : public Mwc713Task {
 public:
@@ -35,11 +71,13 @@ public:
 
     virtual ~TaskOutputs() override {}
 
+    virtual bool consumeEvent(const WEvent & event) override {return parser.processEvent(event);}
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
 private:
     bool showSpent;
+    OutputsStreamParser parser;
 };
 
 // Get outputs and deliver them directly to HODL status
@@ -53,11 +91,13 @@ public:
 
     virtual ~TaskOutputsForAccount() override {}
 
+    virtual bool consumeEvent(const WEvent & event) override {return parser.processEvent(event);}
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
 private:
     QString accountName;
+    OutputsStreamParser parser;
 };
 
 class TaskTransactions : public Mwc713Task {
@@ -70,9 +110,12 @@ public:
 
     virtual ~TaskTransactions() override {}
 
+    virtual bool consumeEvent(const WEvent & event) override {return parser.processEvent(event);}
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+private:
+    TransactionsStreamParser parser;
 };
 
 class TaskTransactionsById : public Mwc713Task {
@@ -93,20 +136,27 @@ public:
 // Just a callback, not a real task
 class TaskAllTransactionsStart : public Mwc713Task {
 public:
-    TaskAllTransactionsStart( MWC713 * wallet713 ) :
-            Mwc713Task("TaskAllTransactionsStart", "", wallet713,"") {}
+    // streamId - transactions are emitted per account if not 0, see MWC713::streamAllTransactions
+    TaskAllTransactionsStart( MWC713 * wallet713, int _streamId, int _accountsNum ) :
+            Mwc713Task(_streamId>0 ? "TaskAllTransactionsStreamStart" : "TaskAllTransactionsStart", "", wallet713,""),
+            streamId(_streamId), accountsNum(_accountsNum) {}
 
     virtual bool processTask(const QVector<WEvent> &events) override;
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+private:
+    int  streamId;
+    int  accountsNum;
 };
 
 class TaskAllTransactionsEnd : public Mwc713Task {
 public:
-    TaskAllTransactionsEnd( MWC713 * wallet713 ) :
-            Mwc713Task("TaskAllTransactionsEnd", "", wallet713,"") {}
+    TaskAllTransactionsEnd( MWC713 * wallet713, int _streamId ) :
+            Mwc713Task(_streamId>0 ? "TaskAllTransactionsStreamEnd" : "TaskAllTransactionsEnd", "", wallet713,""), streamId(_streamId) {}
 
     virtual bool processTask(const QVector<WEvent> &events) override;
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+private:
+    int streamId;
 };
 
 class TaskAllTransactions : public Mwc713Task {
@@ -118,9 +168,12 @@ public:
 
     virtual ~TaskAllTransactions() override {}
 
+    virtual bool consumeEvent(const WEvent & event) override {return parser.processEvent(event);}
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+private:
+    TransactionsStreamParser parser;
 };
 
 
@@ -174,6 +174,7 @@ public:
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 };
 
 // submit file - posts a transaction that has been finalized. Primarily for use with cold storage.
@@ -189,6 +190,7 @@ public:
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 private:
     QString fileTx;
 };
@@ -208,6 +210,7 @@ public:
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 private:
     bool showProgress;
 };
@@ -265,6 +268,7 @@ public:
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isNetworkBound() const override {return true;}
 };
 
 
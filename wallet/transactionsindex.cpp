@@ -0,0 +1,323 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "transactionsindex.h"
+#include "../core/global.h"
+#include "../util/stringutils.h"
+#include <QDateTime>
+#include <QSet>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace wallet {
+
+////////////////////////////////////////////////////////////////////////////////
+// TransactionsQuery
+
+bool TransactionsQuery::isEmpty() const {
+    return text.isEmpty() && minAmount<0 && maxAmount<0 && minHeight<0 && maxHeight<0 && minTime<0 && maxTime<0;
+}
+
+// Parse 'from..to', 'from..', '..to' or single value. Single value is stored as from==to
+static bool parseRange(const QString & value, QString & from, QString & to) {
+    int sep = value.indexOf("..");
+    if (sep<0) {
+        from = to = value;
+    }
+    else {
+        from = value.left(sep);
+        to = value.mid(sep+2);
+    }
+    return !(from.isEmpty() && to.isEmpty());
+}
+
+static bool parseAmount(const QString & str, int64_t & amount) {
+    if (str.isEmpty())
+        return true;
+    QPair<bool, int64_t> nano = util::one2nano(str);
+    if (!nano.first || nano.second<0)
+        return false;
+    amount = nano.second;
+    return true;
+}
+
+static bool parseHeight(const QString & str, int64_t & height) {
+    if (str.isEmpty())
+        return true;
+    bool ok = false;
+    height = str.toLongLong(&ok);
+    return ok && height>=0;
+}
+
+// endOfDay - time of the last second of the day
+static bool parseDate(const QString & str, bool endOfDay, int64_t & time) {
+    if (str.isEmpty())
+        return true;
+    QDate date = QDate::fromString(str, "yyyy-MM-dd");
+    if (!date.isValid())
+        return false;
+    QDateTime dt(date);
+    time = dt.toMSecsSinceEpoch()/1000 + (endOfDay ? 24*3600-1 : 0);
+    return true;
+}
+
+// static
+QString TransactionsQuery::parse(const QString & str, TransactionsQuery & query) {
+    query = TransactionsQuery();
+
+    QStringList texts;
+    for (const QString & token : str.split(' ', QString::SkipEmptyParts)) {
+        int sep = token.indexOf(':');
+        QString key = sep>0 ? token.left(sep).toLower() : "";
+        QString from, to;
+
+        if (key == "amount") {
+            if ( !parseRange(token.mid(sep+1), from, to) || !parseAmount(from, query.minAmount) || !parseAmount(to, query.maxAmount) )
+                return "Invalid amount at '" + token + "'";
+        }
+        else if (key == "height") {
+            if ( !parseRange(token.mid(sep+1), from, to) || !parseHeight(from, query.minHeight) || !parseHeight(to, query.maxHeight) )
+                return "Invalid height at '" + token + "'";
+        }
+        else if (key == "time") {
+            if ( !parseRange(token.mid(sep+1), from, to) || !parseDate(from, false, query.minTime) || !parseDate(to, true, query.maxTime) )
+                return "Invalid date at '" + token + "', expected format is yyyy-MM-dd";
+        }
+        else {
+            texts.push_back(token);
+        }
+    }
+    query.text = texts.join(' ');
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TransactionsIndex
+
+// static
+QString TransactionsIndex::getKey(const WalletTransaction & tx) {
+    // Coinbase transactions doesn't have txid
+    return tx.txid.isEmpty() ? "#" + QString::number(tx.txIdx) : tx.txid;
+}
+
+int TransactionsIndex::addRecord(const QString & account, const WalletTransaction & tx) {
+    int id;
+    if (freeIds.isEmpty()) {
+        id = records.size();
+        records.push_back(Record());
+    }
+    else {
+        id = freeIds.takeLast();
+    }
+
+    Record & rec = records[id];
+    rec.account = account;
+    rec.valid = true;
+    accountRecords[account].insert(getKey(tx), id);
+    updateRecord(id, tx);
+    return id;
+}
+
+void TransactionsIndex::updateRecord(int id, const WalletTransaction & tx) {
+    Record & rec = records[id];
+    rec.tx = tx;
+    rec.amount = std::abs(tx.coinNano);
+    QDateTime time = QDateTime::fromString(tx.creationTime, mwc::DATETIME_TEMPLATE_THIS);
+    rec.time = time.isValid() ? time.toMSecsSinceEpoch()/1000 : -1;
+    sortedDirty = true;
+}
+
+void TransactionsIndex::removeRecord(int id) {
+    records[id] = Record();
+    freeIds.push_back(id);
+    sortedDirty = true;
+}
+
+void TransactionsIndex::setTransactions(const QString & account, const QVector<WalletTransaction> & transactions) {
+    QHash<QString, int> & accRecords = accountRecords[account];
+
+    QSet<QString> keys;
+    keys.reserve(transactions.size());
+    for (const WalletTransaction & tx : transactions) {
+        QString key = getKey(tx);
+        keys.insert(key);
+
+        auto rec = accRecords.constFind(key);
+        if (rec == accRecords.constEnd()) {
+            addRecord(account, tx);
+            continue;
+        }
+        const WalletTransaction & prev = records[rec.value()].tx;
+        // Transaction can change the state only
+        if (prev.txIdx != tx.txIdx || prev.transactionType != tx.transactionType || prev.confirmed != tx.confirmed ||
+                prev.height != tx.height || prev.kernel != tx.kernel || prev.coinNano != tx.coinNano ||
+                prev.address != tx.address || prev.proof != tx.proof || prev.confirmationTime != tx.confirmationTime)
+            updateRecord(rec.value(), tx);
+    }
+
+    // Removing gone transactions, cancelled pending ones
+    for (auto rec = accRecords.begin(); rec != accRecords.end(); ) {
+        if (keys.contains(rec.key())) {
+            ++rec;
+            continue;
+        }
+        removeRecord(rec.value());
+        rec = accRecords.erase(rec);
+    }
+}
+
+void TransactionsIndex::addPendingTransaction(const QString & account, const WalletTransaction & transaction) {
+    if (accountRecords.value(account).contains(getKey(transaction)))
+        return; // mwc713 already reported it
+    addRecord(account, transaction);
+}
+
+void TransactionsIndex::renameAccount(const QString & oldName, const QString & newName) {
+    if (!accountRecords.contains(oldName))
+        return;
+
+    QHash<QString, int> accRecords = accountRecords.take(oldName);
+    for (int id : accRecords)
+        records[id].account = newName;
+    accountRecords.insert(newName, accRecords);
+}
+
+void TransactionsIndex::clear() {
+    records.clear();
+    freeIds.clear();
+    accountRecords.clear();
+    sortedDirty = true;
+}
+
+void TransactionsIndex::ensureSorted() const {
+    if (!sortedDirty)
+        return;
+
+    byText.clear();
+    byAmount.clear();
+    byHeight.clear();
+    byTime.clear();
+
+    for (int id=0; id<records.size(); id++) {
+        const Record & rec = records[id];
+        if (!rec.valid)
+            continue;
+        if (!rec.tx.txid.isEmpty())
+            byText.push_back( QPair<QString,int>(rec.tx.txid.toLower(), id) );
+        if (!rec.tx.kernel.isEmpty())
+            byText.push_back( QPair<QString,int>(rec.tx.kernel.toLower(), id) );
+        if (!rec.tx.address.isEmpty())
+            byText.push_back( QPair<QString,int>(rec.tx.address.toLower(), id) );
+        byAmount.push_back( QPair<int64_t,int>(rec.amount, id) );
+        byHeight.push_back( QPair<int64_t,int>(rec.tx.height, id) );
+        byTime.push_back( QPair<int64_t,int>(rec.time, id) );
+    }
+
+    std::sort(byText.begin(), byText.end());
+    std::sort(byAmount.begin(), byAmount.end());
+    std::sort(byHeight.begin(), byHeight.end());
+    std::sort(byTime.begin(), byTime.end());
+    sortedDirty = false;
+}
+
+bool TransactionsIndex::matches(const Record & rec, const TransactionsQuery & query, const QString & text) const {
+    if (!rec.valid)
+        return false;
+    if (query.minAmount>=0 && rec.amount < query.minAmount)
+        return false;
+    if (query.maxAmount>=0 && rec.amount > query.maxAmount)
+        return false;
+    if (query.minHeight>=0 && rec.tx.height < query.minHeight)
+        return false;
+    if (query.maxHeight>=0 && rec.tx.height > query.maxHeight)
+        return false;
+    if (query.minTime>=0 && rec.time < query.minTime)
+        return false;
+    if (query.maxTime>=0 && rec.time > query.maxTime)
+        return false;
+    if (!text.isEmpty() && !( rec.tx.txid.startsWith(text, Qt::CaseInsensitive) ||
+                              rec.tx.kernel.startsWith(text, Qt::CaseInsensitive) ||
+                              rec.tx.address.startsWith(text, Qt::CaseInsensitive) ) )
+        return false;
+    return true;
+}
+
+// Range [first,last) at the sorted keys
+typedef QVector<QPair<int64_t,int>>::const_iterator RangeIt;
+
+static QPair<RangeIt, RangeIt> findRange(const QVector<QPair<int64_t,int>> & keys, int64_t minVal, int64_t maxVal) {
+    RangeIt first = minVal<0 ? keys.constBegin() :
+                    std::lower_bound(keys.constBegin(), keys.constEnd(), QPair<int64_t,int>(minVal, INT_MIN));
+    RangeIt last = maxVal<0 ? keys.constEnd() :
+                   std::upper_bound(keys.constBegin(), keys.constEnd(), QPair<int64_t,int>(maxVal, INT_MAX));
+    if (last < first)
+        last = first;
+    return QPair<RangeIt, RangeIt>(first, last);
+}
+
+QVector<IndexedTransaction> TransactionsIndex::search(const TransactionsQuery & query, int limit) const {
+    ensureSorted();
+
+    const QString text = query.text.toLower();
+    QVector<int> candidates;
+
+    if (!text.isEmpty()) {
+        auto it = std::lower_bound(byText.constBegin(), byText.constEnd(), QPair<QString,int>(text, INT_MIN));
+        for (; it != byText.constEnd() && it->first.startsWith(text); ++it)
+            candidates.push_back(it->second);
+        // Record can match by several keys
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase( std::unique(candidates.begin(), candidates.end()), candidates.end() );
+    }
+    else {
+        // The most selective range gives the candidates, others are checked for them
+        QPair<RangeIt, RangeIt> best = findRange(byTime, query.minTime, query.maxTime);
+        for (const QPair<RangeIt, RangeIt> & r : { findRange(byAmount, query.minAmount, query.maxAmount),
+                                                   findRange(byHeight, query.minHeight, query.maxHeight) }) {
+            if (r.second - r.first < best.second - best.first)
+                best = r;
+        }
+        for (RangeIt it = best.first; it != best.second; ++it)
+            candidates.push_back(it->second);
+    }
+
+    QVector<int> found;
+    for (int id : candidates) {
+        if (matches(records[id], query, text))
+            found.push_back(id);
+    }
+
+    // Newest first
+    std::sort(found.begin(), found.end(), [this](int a, int b) {
+        const Record & ra = records[a];
+        const Record & rb = records[b];
+        if (ra.time != rb.time)
+            return ra.time > rb.time;
+        if (ra.account != rb.account)
+            return ra.account < rb.account;
+        return ra.tx.txIdx > rb.tx.txIdx;
+    });
+
+    if (limit>0 && found.size()>limit)
+        found.resize(limit);
+
+    QVector<IndexedTransaction> result;
+    result.reserve(found.size());
+    for (int id : found)
+        result.push_back( IndexedTransaction{records[id].account, records[id].tx} );
+    return result;
+}
+
+}
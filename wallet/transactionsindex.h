@@ -0,0 +1,98 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC_QT_WALLET_TRANSACTIONSINDEX_H
+#define MWC_QT_WALLET_TRANSACTIONSINDEX_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include "wallet.h"
+
+namespace wallet {
+
+// Transactions search request. Negative values and empty text are not used
+struct TransactionsQuery {
+    QString text;           // Prefix of txid, kernel or address. Case insensitive
+    int64_t minAmount = -1; // Nano coins, absolute value of the transaction net difference
+    int64_t maxAmount = -1;
+    int64_t minHeight = -1;
+    int64_t maxHeight = -1;
+    int64_t minTime = -1;   // Creation time, seconds since epoch
+    int64_t maxTime = -1;
+
+    bool isEmpty() const;
+
+    // Parse the user input. Tokens:
+    //   amount:<mwc>[..<mwc>]  height:<h>[..<h>]  time:<yyyy-MM-dd>[..<yyyy-MM-dd>]
+    // Range ends can be skipped, like 'height:1000..'. Any other token is a text.
+    // Return error message, empty string if query is fine.
+    static QString parse(const QString & str, TransactionsQuery & query);
+};
+
+struct IndexedTransaction {
+    QString account;
+    WalletTransaction transaction;
+};
+
+// In-memory index of the transactions from all accounts.
+// Updates are incremental, sorted keys are rebuilt on the first search after the changes.
+class TransactionsIndex {
+public:
+    // Set all transactions of the account. Only the differences are applied
+    void setTransactions(const QString & account, const QVector<WalletTransaction> & transactions);
+    // Transaction that mwc713 doesn't list yet (received slate). It will be replaced by setTransactions
+    void addPendingTransaction(const QString & account, const WalletTransaction & transaction);
+
+    bool hasAccount(const QString & account) const {return accountRecords.contains(account);}
+    void renameAccount(const QString & oldName, const QString & newName);
+    void clear();
+
+    int size() const {return records.size() - freeIds.size();}
+
+    // Search across all accounts. Result is sorted by creation time, newest first. limit<=0 - no limit
+    QVector<IndexedTransaction> search(const TransactionsQuery & query, int limit) const;
+
+private:
+    struct Record {
+        QString account;
+        WalletTransaction tx;
+        int64_t amount = 0; // abs(coinNano)
+        int64_t time = -1;  // creation time, seconds since epoch
+        bool    valid = false;
+    };
+
+    static QString getKey(const WalletTransaction & tx);
+    int  addRecord(const QString & account, const WalletTransaction & tx);
+    void updateRecord(int id, const WalletTransaction & tx);
+    void removeRecord(int id);
+    bool matches(const Record & rec, const TransactionsQuery & query, const QString & text) const;
+    void ensureSorted() const;
+
+    QVector<Record> records;
+    QVector<int> freeIds; // deleted records, can be reused
+    QMap<QString, QHash<QString, int>> accountRecords; // account -> transaction key -> record id
+
+    // Sorted keys, rebuilt after changes
+    mutable bool sortedDirty = true;
+    mutable QVector<QPair<QString, int>> byText; // lower case txid, kernel and address
+    mutable QVector<QPair<int64_t, int>> byAmount;
+    mutable QVector<QPair<int64_t, int>> byHeight;
+    mutable QVector<QPair<int64_t, int>> byTime;
+};
+
+}
+
+#endif //MWC_QT_WALLET_TRANSACTIONSINDEX_H
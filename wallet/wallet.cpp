@@ -324,7 +324,7 @@ int64_t WalletTransaction::calculateTransactionAge( const QDateTime & current )
     return setTime.secsTo(current);
 }
 
-QString WalletTransaction::toStringCSV() {
+QString WalletTransaction::toStringCSV() const {
     QString separator = ",";
     // always enclose the type string in quotes as it could contain a comma
     QString txTypeStr = "\"" + getTypeAsStr() + "\"";
@@ -404,12 +404,12 @@ WalletTransaction WalletTransaction::fromJson(QString str) {
 //  WalletOutput
 
 void WalletOutput::setData(QString _outputCommitment,
-        QString     _MMRIndex,
-        QString     _blockHeight,
-        QString     _lockedUntil,
-        QString     _status,
+        int64_t     _MMRIndex,
+        int64_t     _blockHeight,
+        int64_t     _lockedUntil,
+        STATUS      _status,
         bool        _coinbase,
-        QString     _numOfConfirms,
+        int64_t     _numOfConfirms,
         int64_t     _valueNano,
         int64_t     _txIdx)
 {
@@ -425,19 +425,47 @@ void WalletOutput::setData(QString _outputCommitment,
 }
 
 QString WalletOutput::toString() const {
-    return  "Output(" + outputCommitment + ", MMR=" + MMRIndex + ", Height=" + blockHeight + ", Locked=" + lockedUntil + ", status=" +
-            status + ", coinbase=" + (coinbase?"true":"false") + ", confirms=" + numOfConfirms, ", value=" + QString::number(valueNano) + ", txIdx=" + txIdx + ")";
+    return  "Output(" + outputCommitment + ", MMR=" + getMMRIndexStr() + ", Height=" + getBlockHeightStr() + ", Locked=" + getLockedUntilStr() + ", status=" +
+            getStatusStr() + ", coinbase=" + (coinbase?"true":"false") + ", confirms=" + getNumOfConfirmsStr() + ", value=" + QString::number(valueNano) + ", txIdx=" + QString::number(txIdx) + ")";
+}
+
+// static
+QString WalletOutput::status2str(STATUS status) {
+    switch (status) {
+        case STATUS::UNCONFIRMED: return "Unconfirmed";
+        case STATUS::UNSPENT:     return "Unspent";
+        case STATUS::LOCKED:      return "Locked";
+        case STATUS::SPENT:       return "Spent";
+        case STATUS::REVERTED:    return "Reverted";
+        default:                  return "Unknown";
+    }
+}
+
+// static
+WalletOutput::STATUS WalletOutput::str2status(const QString & str) {
+    if (str == "Unspent")
+        return STATUS::UNSPENT;
+    if (str == "Spent")
+        return STATUS::SPENT;
+    if (str == "Locked")
+        return STATUS::LOCKED;
+    if (str == "Unconfirmed")
+        return STATUS::UNCONFIRMED;
+    if (str == "Reverted")
+        return STATUS::REVERTED;
+    return STATUS::UNKNOWN;
 }
 
 QString WalletOutput::toJson() const {
     QJsonObject obj;
     obj.insert("outputCommitment", outputCommitment);
-    obj.insert("MMRIndex", MMRIndex);
-    obj.insert("blockHeight", blockHeight);
-    obj.insert("lockedUntil", lockedUntil);
-    obj.insert("status", status);
+    // QML shows these fields as they are, so they are formatted for UI: status name, empty string for undefined numbers
+    obj.insert("MMRIndex", getMMRIndexStr() );
+    obj.insert("blockHeight", getBlockHeightStr() );
+    obj.insert("lockedUntil", getLockedUntilStr() );
+    obj.insert("status", getStatusStr() );
     obj.insert("coinbase", coinbase);
-    obj.insert("numOfConfirms", numOfConfirms);
+    obj.insert("numOfConfirms", getNumOfConfirmsStr() );
     obj.insert("valueNano", QString::number(valueNano) );
     obj.insert("txIdx", QString::number(txIdx) );
     obj.insert("weight", weight);
@@ -454,14 +482,18 @@ WalletOutput WalletOutput::fromJson(QString str) {
     Q_ASSERT(jsonDoc.isObject());
     QJsonObject obj = jsonDoc.object();
 
+    // Cache files from the previous version can have the status as a number
+    QJsonValue statusVal = obj.value("status");
+    STATUS status = statusVal.isString() ? str2status(statusVal.toString()) : STATUS(statusVal.toInt());
+
     WalletOutput res;
     res.setData(obj.value("outputCommitment").toString(),
-                obj.value("MMRIndex").toString(),
-                obj.value("blockHeight").toString(),
-                obj.value("lockedUntil").toString(),
-                obj.value("status").toString(),
+                str2num(obj.value("MMRIndex").toString()),
+                str2num(obj.value("blockHeight").toString()),
+                str2num(obj.value("lockedUntil").toString()),
+                status,
                 obj.value("coinbase").toBool(),
-                obj.value("numOfConfirms").toString(),
+                str2num(obj.value("numOfConfirms").toString()),
                 obj.value("valueNano").toString().toLongLong(),
                 obj.value("txIdx").toString().toLongLong());
     return res;
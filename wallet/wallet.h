@@ -33,6 +33,10 @@ class MwcNode;
 
 namespace wallet {
 
+class SpendableOutputs;
+struct TransactionsQuery;
+struct IndexedTransaction;
+
 struct AccountInfo {
     QString accountName = "default";
     int64_t height = 0;
@@ -172,35 +176,37 @@ public:
 };
 
 struct WalletOutput {
+    // Output status from mwc713. Strings are needed at UI only
+    enum class STATUS : int8_t { UNKNOWN=0, UNCONFIRMED=1, UNSPENT=2, LOCKED=3, SPENT=4, REVERTED=5 };
 
     QString    outputCommitment;
-    QString    MMRIndex;
-    QString    blockHeight;
-    QString    lockedUntil;
-    QString    status;
-    bool       coinbase = false;
-    QString    numOfConfirms;
+    int64_t    MMRIndex = -1;     // -1 - not defined
+    int64_t    blockHeight = -1;  // -1 - not defined
+    int64_t    lockedUntil = -1;  // -1 - not defined
+    int64_t    numOfConfirms = 0;
     int64_t    valueNano = 0L;
-    int64_t    txIdx;
+    int64_t    txIdx = -1;
     double     weight = 0.0; // HODL weight, used for ouptus optimization
+    STATUS     status = STATUS::UNKNOWN;
+    bool       coinbase = false;
 
     void setData(QString outputCommitment,
-            QString     MMRIndex,
-            QString     blockHeight,
-            QString     lockedUntil,
-            QString     status,
+            int64_t     MMRIndex,
+            int64_t     blockHeight,
+            int64_t     lockedUntil,
+            STATUS      status,
             bool        coinbase,
-            QString     numOfConfirms,
+            int64_t     numOfConfirms,
             int64_t     valueNano,
             int64_t     txIdx);
 
     static WalletOutput create(QString outputCommitment,
-                               QString     MMRIndex,
-                               QString     blockHeight,
-                               QString     lockedUntil,
-                               QString     status,
+                               int64_t     MMRIndex,
+                               int64_t     blockHeight,
+                               int64_t     lockedUntil,
+                               STATUS      status,
                                bool        coinbase,
-                               QString     numOfConfirms,
+                               int64_t     numOfConfirms,
                                int64_t     valueNano,
                                int64_t     txIdx) {
         WalletOutput item;
@@ -214,15 +220,29 @@ struct WalletOutput {
     QString toString() const;
 
     bool isValid() const {
-        return !(outputCommitment.isEmpty() || status.isEmpty());
+        return !(outputCommitment.isEmpty() || status == STATUS::UNKNOWN);
     }
 
     double getWeightedValue() const {return weight*valueNano; }
 
-    bool isUnspent() const {return status == "Unspent";}
+    bool isUnspent() const {return status == STATUS::UNSPENT;}
+
+    // Formatting for UI
+    QString getStatusStr() const {return status2str(status);}
+    QString getMMRIndexStr() const {return num2str(MMRIndex);}
+    QString getBlockHeightStr() const {return num2str(blockHeight);}
+    QString getLockedUntilStr() const {return num2str(lockedUntil);}
+    QString getNumOfConfirmsStr() const {return QString::number(numOfConfirms);}
+
+    static QString status2str(STATUS status);
+    // Parse mwc713 status string. Return UNKNOWN for unexpected values
+    static STATUS str2status(const QString & str);
 
     QString toJson() const;
     static WalletOutput fromJson(QString str);
+
+    static QString num2str(int64_t val) {return val<0 ? "" : QString::number(val);}
+    static int64_t str2num(const QString & str) {return str.isEmpty() ? -1 : str.toLongLong();}
 };
 
 struct WalletTransaction {
@@ -314,7 +334,7 @@ struct WalletTransaction {
     }
 
     // return transactions values formatted into a CSV string
-    QString toStringCSV();
+    QString toStringCSV() const;
 
     QString toJson() const;
     static WalletTransaction fromJson(QString str);
@@ -517,6 +537,10 @@ public:
     // Get outputs that was collected for this wallet. Outputs should be ready with balances
     virtual const QMap<QString, QVector<wallet::WalletOutput> > & getwalletOutputs() const = 0;
 
+    // Get outputs of the account that can be spent now, sorted by value.
+    // Index is maintained by wallet, so it is cheap to call it frequently
+    virtual const SpendableOutputs & getSpendableOutputs(const QString & accountName) = 0;
+
     virtual QString getCurrentAccountName()  = 0;
 
     // Request sync (update_wallet_state) for the
@@ -528,6 +552,11 @@ public:
     //          onWalletBalanceProgress
     virtual void updateWalletBalance(bool enforceSync, bool showSyncProgress, bool skipSync=false)  = 0;
 
+    // Request Wallet balance update only if something might change since the last update:
+    // new block, slates, cancellations. Only affected accounts are refreshed.
+    // Check signal: onWalletBalanceUpdated
+    virtual void updateWalletBalanceIfChanged(bool enforceSync) = 0;
+
 
     // Create another account, note no delete exist for accounts
     // Check Signal:  onAccountCreated
@@ -561,9 +590,10 @@ public:
     virtual bool setWalletConfig(const WalletConfig & config, bool canStartNode )  = 0;
 
     // Status of the node
-    // return true if task was scheduled
+    // useCached - recent status is shared by all callers without the node request. Pollers should use false.
+    // return true if task was scheduled or cached status was emitted
     // Check Signal: onNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, int64_t totalDifficulty, int connections )
-    virtual bool getNodeStatus() = 0;
+    virtual bool getNodeStatus(bool useCached = true) = 0;
 
     // Set account that will receive the funds
     // Check Signal:  onSetReceiveAccount( bool ok, QString AccountOrMessage );
@@ -631,6 +661,22 @@ public:
     // Check Signal: onAllTransactions( QVector<WalletTransaction> Transactions)
     virtual void getAllTransactions() = 0;
 
+    // Read transactions account by account. account - account to read, empty for all accounts.
+    // Nothing is collected, data is emitted as soon as account transactions are received. Use it for the large exports.
+    // Every call is served, streams are processed in the order of the calls.
+    // Every stream is finished with onAllTransactionsStreamEnd, even if mwc713 is stopped in the middle.
+    // Return: stream id, signals are marked with it.
+    // Check Signals: onAllTransactionsChunk( int streamId, QString account, int accountIdx, int accountsNum, QVector<WalletTransaction> Transactions)
+    //                onAllTransactionsStreamEnd( int streamId, bool completed )
+    virtual int streamAllTransactions(QString account) = 0;
+
+    // Search transactions from all accounts at the wallet transactions index. It is fast, no mwc713 requests.
+    // Result is sorted by creation time, newest first. limit<=0 - no limit
+    virtual QVector<IndexedTransaction> searchTransactions(const TransactionsQuery & query, int limit) = 0;
+    // Accounts that are not in the transactions index yet, search doesn't cover them.
+    // They are requested from mwc713 at the background after login.
+    virtual QVector<QString> getNotIndexedAccounts() = 0;
+
 
     // ----------- HODL
     // https://github.com/mimblewimble/grin/pull/2374
@@ -768,6 +814,11 @@ signals:
 
     void onAllTransactions( QVector<WalletTransaction> Transactions);
 
+    // streamAllTransactions data. accountIdx is in range [0..accountsNum)
+    void onAllTransactionsChunk( int streamId, QString account, int accountIdx, int accountsNum, QVector<WalletTransaction> Transactions);
+    // completed is false if the stream was aborted because mwc713 was stopped
+    void onAllTransactionsStreamEnd( int streamId, bool completed );
+
     void onOutputs( QString account, bool showSpent, int64_t height, QVector<WalletOutput> outputs);
 
     void onCheckResult(bool ok, QString errors );
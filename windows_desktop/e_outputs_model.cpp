@@ -0,0 +1,301 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "e_outputs_model.h"
+#include "../bridge/config_b.h"
+#include "../bridge/hodlstatus_b.h"
+#include "../util/stringutils.h"
+#include <QBrush>
+#include <QColor>
+#include <QSet>
+
+namespace wnd {
+
+// Confirmations are calculated from the tip height, they are not compared
+static bool isSameOutput(const wallet::WalletOutput & a, const wallet::WalletOutput & b) {
+    return a.outputCommitment == b.outputCommitment && a.MMRIndex == b.MMRIndex && a.blockHeight == b.blockHeight &&
+           a.lockedUntil == b.lockedUntil && a.status == b.status && a.coinbase == b.coinbase &&
+           a.valueNano == b.valueNano && a.txIdx == b.txIdx && a.weight == b.weight;
+}
+
+OutputsModel::OutputsModel(QObject * parent, bridge::Config * _config, bridge::HodlStatus * _hodlStatus,
+                           bool showLocked, bool showHodl) :
+    QAbstractTableModel(parent),
+    config(_config),
+    hodlStatus(_hodlStatus)
+{
+    columns = QVector<COLUMN>{COL_TXIDX, COL_AMOUNT, COL_STATUS, COL_CONFIRMS, COL_COMMITMENT, COL_COINBASE, COL_HEIGHT, COL_LOCK_HEIGHT};
+    if (showLocked)
+        columns.insert(columns.indexOf(COL_CONFIRMS), COL_LOCKED);
+    if (showHodl)
+        columns.push_back(COL_HODL);
+}
+
+OutputsModel::~OutputsModel() {}
+
+void OutputsModel::setOutputs( const QVector<wallet::WalletOutput> & newOutputs, int64_t height ) {
+    outputsHeight = height;
+
+    QSet<QString> newCommits;
+    newCommits.reserve(newOutputs.size());
+    for (const wallet::WalletOutput & o : newOutputs)
+        newCommits.insert(o.outputCommitment);
+
+    QVector<int> removed;
+    for (int i=0; i<outputs.size(); i++) {
+        if (!newCommits.contains(outputs[i].outputCommitment))
+            removed.push_back(i);
+    }
+
+    if ( removed.size() > outputs.size()/2 ) {
+        // Mostly new data (another account). Reset is cheaper
+        beginResetModel();
+        outputs.clear();
+        rowByCommitment.clear();
+        for (const wallet::WalletOutput & o : newOutputs) {
+            if (rowByCommitment.contains(o.outputCommitment))
+                continue;
+            rowByCommitment.insert(o.outputCommitment, outputs.size());
+            outputs.push_back(o);
+        }
+        endResetModel();
+        return;
+    }
+
+    if (!removed.isEmpty()) {
+        // Removing from the end by continuous ranges, so indexes are stay valid
+        int k = removed.size()-1;
+        while (k>=0) {
+            const int last = removed[k];
+            int first = last;
+            while (k>0 && removed[k-1]==first-1) {
+                k--;
+                first--;
+            }
+            k--;
+            beginRemoveRows( QModelIndex(), first, last );
+            outputs.remove(first, last-first+1);
+            endRemoveRows();
+        }
+
+        rowByCommitment.clear();
+        for (int i=0; i<outputs.size(); i++)
+            rowByCommitment.insert(outputs[i].outputCommitment, i);
+    }
+
+    QVector<wallet::WalletOutput> added;
+    for (const wallet::WalletOutput & o : newOutputs) {
+        auto row = rowByCommitment.constFind(o.outputCommitment);
+        if (row == rowByCommitment.constEnd()) {
+            rowByCommitment.insert(o.outputCommitment, -1); // placeholder, skipping duplicates
+            added.push_back(o);
+            continue;
+        }
+        if (row.value()<0)
+            continue;
+
+        wallet::WalletOutput & out = outputs[row.value()];
+        if ( isSameOutput(out, o) ) {
+            out.numOfConfirms = o.numOfConfirms; // Confirmations column will be updated once for all rows
+        }
+        else {
+            out = o;
+            emit dataChanged( index(row.value(),0), index(row.value(), columns.size()-1) );
+        }
+    }
+
+    if (!added.isEmpty()) {
+        beginInsertRows( QModelIndex(), outputs.size(), outputs.size() + added.size() - 1 );
+        for (const wallet::WalletOutput & o : added) {
+            rowByCommitment.insert(o.outputCommitment, outputs.size());
+            outputs.push_back(o);
+        }
+        endInsertRows();
+    }
+
+    emitColumnChanged(COL_CONFIRMS);
+}
+
+void OutputsModel::clear() {
+    if (outputs.isEmpty())
+        return;
+
+    beginResetModel();
+    outputs.clear();
+    rowByCommitment.clear();
+    endResetModel();
+}
+
+void OutputsModel::setTipHeight(int64_t height) {
+    if (tipHeight == height)
+        return;
+    tipHeight = height;
+    emitColumnChanged(COL_CONFIRMS);
+}
+
+void OutputsModel::updateLockState(const QString & commitment) {
+    int row = rowByCommitment.value(commitment, -1);
+    if (row<0)
+        return;
+    // Lock state can be used by filter, the whole row is updated
+    emit dataChanged( index(row,0), index(row, columns.size()-1) );
+}
+
+void OutputsModel::emitColumnChanged(COLUMN col) {
+    int column = getColumnIndex(col);
+    if (column<0 || outputs.isEmpty())
+        return;
+    emit dataChanged( index(0,column), index(outputs.size()-1,column) );
+}
+
+const wallet::WalletOutput * OutputsModel::getOutput(int row) const {
+    if (row<0 || row>=outputs.size())
+        return nullptr;
+    return &outputs[row];
+}
+
+int64_t OutputsModel::getConfirmations(const wallet::WalletOutput & out) const {
+    // Not mined outputs don't have confirmations
+    if (out.numOfConfirms <= 0 || outputsHeight <= 0 || tipHeight <= outputsHeight)
+        return out.numOfConfirms;
+    return out.numOfConfirms + (tipHeight - outputsHeight);
+}
+
+bool OutputsModel::isLocked(const wallet::WalletOutput & out) const {
+    return out.isUnspent() && config->isLockedOutput(out.outputCommitment);
+}
+
+int OutputsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : outputs.size();
+}
+
+int OutputsModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : columns.size();
+}
+
+QVariant OutputsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row()>=outputs.size() || index.column()>=columns.size())
+        return QVariant();
+
+    const wallet::WalletOutput & out = outputs[index.row()];
+    const COLUMN column = columns[index.column()];
+
+    switch (role) {
+        case Qt::DisplayRole:
+            return getCellText(out, column);
+        case Qt::TextAlignmentRole:
+            return int(Qt::AlignCenter);
+        case Qt::BackgroundRole:
+            // Lock column is clickable, highlighting it
+            if (column == COL_LOCKED)
+                return QBrush( QColor(255,255,255,50) );
+            return QVariant();
+        case SortRole:
+            return getSortValue(out, column);
+        default:
+            return QVariant();
+    }
+}
+
+QVariant OutputsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section<0 || section>=columns.size())
+        return QVariant();
+
+    switch (columns[section]) {
+        case COL_TXIDX:       return "TX #";
+        case COL_AMOUNT:      return "MWC";
+        case COL_STATUS:      return "STATUS";
+        case COL_LOCKED:      return "LOCKED";
+        case COL_CONFIRMS:    return "CONF";
+        case COL_COMMITMENT:  return "COMMITMENT";
+        case COL_COINBASE:    return "CB";
+        case COL_HEIGHT:      return "HEIGHT";
+        case COL_LOCK_HEIGHT: return "LOCK H";
+        case COL_HODL:        return "HODL";
+        default:              return QVariant();
+    }
+}
+
+QString OutputsModel::getCellText(const wallet::WalletOutput & out, COLUMN column) const {
+    switch (column) {
+        case COL_TXIDX:       return QString::number(out.txIdx + 1);
+        case COL_AMOUNT:      return util::nano2one(out.valueNano);
+        case COL_STATUS:      return out.getStatusStr();
+        case COL_LOCKED:      return out.isUnspent() ? (isLocked(out) ? "YES" : "NO") : "N/A";
+        case COL_CONFIRMS:    return QString::number( getConfirmations(out) );
+        case COL_COMMITMENT:  return out.outputCommitment;
+        case COL_COINBASE:    return out.coinbase ? "Yes" : "No";
+        case COL_HEIGHT:      return out.getBlockHeightStr();
+        case COL_LOCK_HEIGHT: return out.getLockedUntilStr();
+        case COL_HODL:        return hodlStatus->getOutputHodlStatus(out.outputCommitment);
+        default:              return "";
+    }
+}
+
+QVariant OutputsModel::getSortValue(const wallet::WalletOutput & out, COLUMN column) const {
+    switch (column) {
+        case COL_TXIDX:       return qlonglong(out.txIdx);
+        case COL_AMOUNT:      return qlonglong(out.valueNano);
+        case COL_STATUS:      return int(out.status);
+        case COL_CONFIRMS:    return qlonglong(getConfirmations(out));
+        case COL_HEIGHT:      return qlonglong(out.blockHeight);
+        case COL_LOCK_HEIGHT: return qlonglong(out.lockedUntil);
+        default:              return getCellText(out, column);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// OutputsFilterModel
+
+OutputsFilterModel::OutputsFilterModel(QObject * parent) :
+    QSortFilterProxyModel(parent)
+{
+    setSortRole(OutputsModel::SortRole);
+    setDynamicSortFilter(true);
+}
+
+void OutputsFilterModel::setOutputsModel(OutputsModel * model) {
+    outputsModel = model;
+    setSourceModel(model);
+}
+
+void OutputsFilterModel::setShowSpent(bool show) {
+    if (showSpent == show)
+        return;
+    showSpent = show;
+    invalidateFilter();
+}
+
+void OutputsFilterModel::setHideLocked(bool hide) {
+    if (hideLocked == hide)
+        return;
+    hideLocked = hide;
+    invalidateFilter();
+}
+
+bool OutputsFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+    Q_UNUSED(sourceParent)
+    Q_ASSERT(outputsModel);
+    const wallet::WalletOutput * out = outputsModel->getOutput(sourceRow);
+    if (out == nullptr)
+        return false;
+
+    if (!showSpent && out->status == wallet::WalletOutput::STATUS::SPENT)
+        return false;
+    if (hideLocked && outputsModel->isLocked(*out))
+        return false;
+    return true;
+}
+
+}
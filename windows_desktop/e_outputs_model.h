@@ -0,0 +1,110 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_E_OUTPUTS_MODEL_H
+#define MWC_QT_WALLET_E_OUTPUTS_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+#include <QHash>
+#include "../wallet/wallet.h"
+
+namespace bridge {
+class Config;
+class HodlStatus;
+}
+
+namespace wnd {
+
+// Outputs of a single account for the outputs page. Rows are keyed by commitment,
+// cells text is built on request, so only visible rows are materialized.
+class OutputsModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum COLUMN {COL_TXIDX=0, COL_AMOUNT, COL_STATUS, COL_LOCKED, COL_CONFIRMS, COL_COMMITMENT,
+                 COL_COINBASE, COL_HEIGHT, COL_LOCK_HEIGHT, COL_HODL};
+
+    // Role for the sort proxy. Numeric for the number columns
+    static const int SortRole = Qt::UserRole;
+
+    // showLocked - show 'LOCKED' column. showHodl - show 'HODL' column
+    OutputsModel(QObject * parent, bridge::Config * config, bridge::HodlStatus * hodlStatus,
+                 bool showLocked, bool showHodl);
+    virtual ~OutputsModel() override;
+
+    // Update the outputs. height - the height when the outputs was requested.
+    // Rows are matched by commitment, only changed, new and removed rows are reported to the view.
+    void setOutputs( const QVector<wallet::WalletOutput> & outputs, int64_t height );
+    void clear();
+
+    // New node tip. Only confirmations column is updated
+    void setTipHeight(int64_t height);
+    // Lock state was changed for the output
+    void updateLockState(const QString & commitment);
+
+    // Return null for invalid row
+    const wallet::WalletOutput * getOutput(int row) const;
+    // Confirmations for the current tip height
+    int64_t getConfirmations(const wallet::WalletOutput & out) const;
+    bool isLocked(const wallet::WalletOutput & out) const;
+
+    // Column index at the view. -1 if column is not shown
+    int getColumnIndex(COLUMN col) const {return columns.indexOf(col);}
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QString getCellText(const wallet::WalletOutput & out, COLUMN column) const;
+    QVariant getSortValue(const wallet::WalletOutput & out, COLUMN column) const;
+    void emitColumnChanged(COLUMN col);
+
+private:
+    bridge::Config * config = nullptr;
+    bridge::HodlStatus * hodlStatus = nullptr;
+
+    QVector<COLUMN> columns; // Shown columns
+    QVector<wallet::WalletOutput> outputs;
+    QHash<QString, int> rowByCommitment;
+
+    int64_t outputsHeight = 0; // Height when outputs was requested, confirmations are for this height
+    int64_t tipHeight = 0;
+};
+
+// Status and lock filters for the OutputsModel. Filtering is done on the model data, no new requests to the wallet needed.
+class OutputsFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+public:
+    explicit OutputsFilterModel(QObject * parent);
+
+    void setOutputsModel(OutputsModel * model);
+
+    // false - spent outputs are hidden
+    void setShowSpent(bool show);
+    void setHideLocked(bool hide);
+
+protected:
+    virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    OutputsModel * outputsModel = nullptr;
+    bool showSpent = true;
+    bool hideLocked = false;
+};
+
+}
+
+#endif //MWC_QT_WALLET_E_OUTPUTS_MODEL_H
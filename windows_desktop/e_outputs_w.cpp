@@ -14,6 +14,7 @@
 
 #include "e_outputs_w.h"
 #include "ui_e_outputs.h"
+#include "e_outputs_model.h"
 #include <QDebug>
 #include <control_desktop/messagebox.h>
 #include "../dialogs_desktop/e_showoutputdlg.h"
@@ -25,8 +26,6 @@
 
 namespace wnd {
 
-const int LOCK_OUTPUT_COLUMN_IDX = 3;
-
 // static
 bool Outputs::lockMessageWasShown = false;
 
@@ -46,8 +45,9 @@ Outputs::Outputs(QWidget *parent) :
                       this, &Outputs::onSgnWalletBalanceUpdated, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnNewNotificationMessage,
                       this, &Outputs::onSgnNewNotificationMessage, Qt::QueuedConnection);
+    QObject::connect( wallet, &bridge::Wallet::sgnNodeStatus,
+                      this, &Outputs::onSgnNodeStatus, Qt::QueuedConnection);
 
-    ui->outputsTable->setHightlightColors(QColor(255, 255, 255, 51), QColor(255, 255, 255, 153)); // Alpha: 0.2  - 0.6
     // Alpha delta for row stripe coloring. Range 0-255
     ui->outputsTable->setStripeAlfaDelta(5); // very small number
 
@@ -63,6 +63,18 @@ Outputs::Outputs(QWidget *parent) :
     inHodl = hodlStatus->isInHodl();
     canLockOutputs = config->isLockOutputEnabled();
 
+    ui->hideLocked->setVisible(canLockOutputs);
+
+    outputsModel = new OutputsModel(this, config, hodlStatus, canLockOutputs, inHodl);
+    outputsFilter = new OutputsFilterModel(this);
+    outputsFilter->setOutputsModel(outputsModel);
+    outputsFilter->setShowSpent(showAll);
+
+    ui->outputsTable->setModel(outputsFilter);
+    // Newest outputs first
+    ui->outputsTable->setSortingEnabled(true);
+    ui->outputsTable->sortByColumn(outputsModel->getColumnIndex(OutputsModel::COL_TXIDX), Qt::DescendingOrder);
+
     initTableHeaders();
 
     requestOutputs(accName);
@@ -81,20 +93,16 @@ Outputs::~Outputs() {
 
 void Outputs::initTableHeaders() {
 
+    // Column names are provided by outputsModel
     tableId = "Outputs_N";
-    QVector<QString> columns{"TX #", "MWC", "STATUS", "CONF", "COMMITMENT", "CB", "HEIGHT", "LOCK H" };
     QVector<int> widths{40, 90, 100, 70, 240, 50, 70, 70};
 
     if (canLockOutputs) {
-        columns.insert(LOCK_OUTPUT_COLUMN_IDX, "LOCKED");
-        widths.insert(LOCK_OUTPUT_COLUMN_IDX, 60);
+        widths.insert(outputsModel->getColumnIndex(OutputsModel::COL_LOCKED), 60);
         tableId += "L";
-
-        ui->outputsTable->addHighlightedColumn(LOCK_OUTPUT_COLUMN_IDX);
     }
 
     if (inHodl) {
-        columns.push_back("HODL");
         widths.push_back(60);
         tableId += "H";
     }
@@ -104,12 +112,7 @@ void Outputs::initTableHeaders() {
         widths = ww;
     }
 
-    ui->outputsTable->setColumnCount(widths.size());
-    for (int t=0; t<widths.size(); t++) {
-        ui->outputsTable->setColumnWidth(t, widths[t]);
-        QTableWidgetItem * itm = new QTableWidgetItem( columns[t]) ;
-        ui->outputsTable->setHorizontalHeaderItem( t, itm );
-    }
+    ui->outputsTable->setColumnWidths(widths);
 }
 
 void Outputs::saveTableHeaders() {
@@ -117,135 +120,72 @@ void Outputs::saveTableHeaders() {
     config->updateColumnsWidhts( tableId, width );
 }
 
-int Outputs::calcPageSize() const {
-    QSize sz1 = ui->outputsTable->size();
-    QSize sz2 = ui->progressFrame->size();
-
-    return ListWithColumns::getNumberOfVisibleRows(std::max(sz1.height(), std::max(0, sz2.height() - 50)));
-}
-
-
-void Outputs::on_prevBtn_clicked() {
-    if (currentPagePosition > 0) {
-        int pageSize = calcPageSize();
-        currentPagePosition = std::max( 0, currentPagePosition-pageSize );
-        updateShownData();
-    }
-}
-
-void Outputs::on_nextBtn_clicked() {
-    if (currentPagePosition + shownData.size() < allData.size()) {
-        int pageSize = calcPageSize();
-        currentPagePosition = std::min( allData.size()-pageSize, currentPagePosition+pageSize );
-        updateShownData();
-    }
-}
-
-void Outputs::updateShownData() {
-    int pageSize = calcPageSize();
-    shownData.clear();
-    ui->outputsTable->clearData();
-    if (currentPagePosition < 0 || allData.isEmpty() || pageSize <= 0) {
-        ui->nextBtn->setEnabled(false);
-        ui->prevBtn->setEnabled(false);
+void Outputs::updateCountLabel() {
+    int total = outputsModel->rowCount();
+    int shown = outputsFilter->rowCount();
+    if (total <= 0)
         ui->pageLabel->setText("");
-        return;
-    } else {
-        int total = allData.size();
-
-        ui->nextBtn->setEnabled(currentPagePosition < total - pageSize);
-        ui->prevBtn->setEnabled(currentPagePosition > 0);
-
-
-        if (total <= 1) {
-            ui->pageLabel->setText(QString::number(total) +
-                                   " of " + QString::number(total));
-        } else {
-            ui->pageLabel->setText(QString::number(currentPagePosition + 1) + "-" +
-                                   QString::number(std::min(currentPagePosition + pageSize - 1 + 1, total)) +
-                                   " of " + QString::number(total));
-        }
-
-        for (int i=currentPagePosition; i<total && pageSize>0; i++, pageSize--) {
-            shownData.push_back(allData[i]);
-        }
-
-        ui->outputsTable->clearData();
-
-        qDebug() << "updating output table for " << shownData.size() << " rows";
-        int row = 0;
-        for (int i = shownData.size()-1; i >= 0; i--) {
-            auto &out = shownData[i];
-
-            QVector<QString> rowData{
-                    QString::number(out.txIdx + 1),
-                    // out.status, // Status allways 'unspent', so no reasons to print it.
-                    util::nano2one(out.valueNano),
-                    out.status,
-                    out.numOfConfirms,
-                    out.outputCommitment,
-                    out.coinbase ? "Yes" : "No",
-                    out.blockHeight,
-                    out.lockedUntil
-            };
-
-            if (canLockOutputs) {
-                rowData.insert(LOCK_OUTPUT_COLUMN_IDX, "" );
-            }
-
-            if (inHodl) {
-                rowData.push_back( hodlStatus->getOutputHodlStatus(out.outputCommitment) );
-            }
-
-            ui->outputsTable->appendRow( rowData );
-
-            showLockedState(row++, out);
-        }
-    }
+    else if (shown == total)
+        ui->pageLabel->setText( QString::number(total) + (total==1 ? " output" : " outputs") );
+    else
+        ui->pageLabel->setText( QString::number(shown) + " of " + QString::number(total) );
 }
 
 QString Outputs::currentSelectedAccount() {
     return ui->accountComboBox->currentData().toString();
 }
 
-void Outputs::onSgnOutputs( QString account, bool showSpent, QString height, QVector<QString> outputs) {
-    Q_UNUSED(height);
-
-    if (account != currentSelectedAccount() || showSpent != isShowUnspent())
+void Outputs::onSgnOutputs( QString acc, bool showSpent, QString height, QVector<QString> outputs) {
+    // Spent outputs are filtered by outputsFilter, so we always need all of them
+    if (acc != currentSelectedAccount() || !showSpent)
         return;
 
     ui->progressFrame->hide();
     ui->tableFrame->show();
 
-    allData.clear();
-    shownData.clear();
+    if (account != acc) {
+        outputsModel->clear();
+        account = acc;
+    }
 
+    QVector<wallet::WalletOutput> data;
+    data.reserve(outputs.size());
     for (const QString & s : outputs) {
-        allData.push_back( wallet::WalletOutput::fromJson(s) );
+        data.push_back( wallet::WalletOutput::fromJson(s) );
     }
 
-    int pageSize = calcPageSize();
-    currentPagePosition = std::max(0, allData.size() - pageSize);
+    // Only changed rows will be updated, selection and scroll position stay
+    outputsModel->setOutputs(data, height.toLongLong());
+    updateCountLabel();
+}
+
+void Outputs::onSgnNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, QString totalDifficulty, int connections ) {
+    Q_UNUSED(errMsg);
+    Q_UNUSED(peerHeight);
+    Q_UNUSED(totalDifficulty);
+    Q_UNUSED(connections);
 
-    updateShownData();
+    if (online)
+        outputsModel->setTipHeight(nodeHeight);
 }
 
 void Outputs::on_refreshButton_clicked() {
     requestOutputs(currentSelectedAccount());
 }
 
-// Request and reset page counter
 void Outputs::requestOutputs(QString account) {
-    currentPagePosition = INT_MAX; // Reset Paging
-    allData.clear();
-    shownData.clear();
+    if (account.isEmpty()) {
+        outputsModel->clear();
+        this->account = "";
+        updateCountLabel();
+        return;
+    }
 
     ui->progressFrame->show();
     ui->tableFrame->hide();
 
-    updateShownData();
-
-    wallet->requestOutputs(account, isShowUnspent(), true);
+    wallet->requestNodeStatus(); // Need to know the tip for confirmations
+    wallet->requestOutputs(account, true, true);
 }
 
 void Outputs::on_accountComboBox_activated(int index) {
@@ -287,34 +227,30 @@ QString Outputs::updateAccountsData() {
 void Outputs::on_showAll_clicked() {
     ui->showAll->setEnabled(false);
     ui->showUnspent->setEnabled(true);
-    on_refreshButton_clicked();
+    outputsFilter->setShowSpent(true);
+    updateCountLabel();
 }
 
 void Outputs::on_showUnspent_clicked() {
     ui->showAll->setEnabled(true);
     ui->showUnspent->setEnabled(false);
-    on_refreshButton_clicked();
+    outputsFilter->setShowSpent(false);
+    updateCountLabel();
 }
 
-bool Outputs::isShowUnspent() const {
-    return !ui->showAll->isEnabled();
+void Outputs::on_hideLocked_stateChanged(int state) {
+    outputsFilter->setHideLocked(state == Qt::Checked);
+    updateCountLabel();
 }
 
-// return null if nothing was selected
-wallet::WalletOutput * Outputs::getSelectedOutput() {
-    int row = ui->outputsTable->getSelectedRow();
-    if (row<0 || row>=shownData.size())
-        return nullptr;
-
-    return &shownData[shownData.size()-1-row];
+bool Outputs::isShowUnspent() const {
+    return !ui->showAll->isEnabled();
 }
 
-void Outputs::on_outputsTable_cellDoubleClicked(int row, int column)
+void Outputs::on_outputsTable_doubleClicked(const QModelIndex &index)
 {
-    Q_UNUSED(row);
-    Q_UNUSED(column);
     util::TimeoutLockObject to( "Outputs");
-    wallet::WalletOutput * selected = getSelectedOutput();
+    const wallet::WalletOutput * selected = outputsModel->getOutput( ui->outputsTable->mapToSourceRow(index) );
 
     if (selected==nullptr)
         return;
@@ -333,21 +269,20 @@ void Outputs::on_outputsTable_cellDoubleClicked(int row, int column)
         if (locked != showOutputDlg.isLocked()) {
             if (showLockMessage()) {
                 // Updating the state
-                config->setLockedOutput(showOutputDlg.isLocked(), out.outputCommitment);
-                showLockedState(row, out);
+                setLockedState(out, showOutputDlg.isLocked());
             }
         }
     }
 }
 
-void Outputs::on_outputsTable_cellClicked(int row, int column)
+void Outputs::on_outputsTable_clicked(const QModelIndex &index)
 {
     if (!canLockOutputs)
         return;
 
     // We can change the lock flag
-    if (column == LOCK_OUTPUT_COLUMN_IDX) {
-        wallet::WalletOutput * selected = getSelectedOutput();
+    if (index.column() == outputsModel->getColumnIndex(OutputsModel::COL_LOCKED)) {
+        const wallet::WalletOutput * selected = outputsModel->getOutput( ui->outputsTable->mapToSourceRow(index) );
         if (selected==nullptr)
             return;
 
@@ -357,22 +292,16 @@ void Outputs::on_outputsTable_cellClicked(int row, int column)
         wallet::WalletOutput out = *selected;
 
         if (showLockMessage()) {
-            bool locked = !config->isLockedOutput(out.outputCommitment);
-            config->setLockedOutput(locked, out.outputCommitment);
-            showLockedState(row, out);
+            setLockedState(out, !config->isLockedOutput(out.outputCommitment));
         }
     }
 }
 
-void Outputs::showLockedState(int row, const wallet::WalletOutput & output) {
-    if (!canLockOutputs)
-        return;
-
-    QString lockState = "N/A";
-    if (output.isUnspent()) {
-            lockState = config->isLockedOutput(output.outputCommitment) ? "YES" : "NO";
-    }
-    ui->outputsTable->setItemText(row,LOCK_OUTPUT_COLUMN_IDX, lockState);
+void Outputs::setLockedState(const wallet::WalletOutput & output, bool locked) {
+    config->setLockedOutput(locked, output.outputCommitment);
+    // Only this row is updated, filter will be applied to it
+    outputsModel->updateLockState(output.outputCommitment);
+    updateCountLabel();
 }
 
 void Outputs::saveOutputNote( QString commitment, QString note) {
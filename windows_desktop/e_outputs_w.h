@@ -31,6 +31,9 @@ class Outputs;
 
 namespace wnd {
 
+class OutputsModel;
+class OutputsFilterModel;
+
 class Outputs : public core::NavWnd
 {
     Q_OBJECT
@@ -41,18 +44,18 @@ public:
 
 private slots:
     void on_accountComboBox_activated(int index);
-    void on_prevBtn_clicked();
-    void on_nextBtn_clicked();
     void on_refreshButton_clicked();
     void on_showAll_clicked();
     void on_showUnspent_clicked();
-    void on_outputsTable_cellDoubleClicked(int row, int column);
-    void on_outputsTable_cellClicked(int row, int column);
+    void on_hideLocked_stateChanged(int state);
+    void on_outputsTable_doubleClicked(const QModelIndex &index);
+    void on_outputsTable_clicked(const QModelIndex &index);
 
     void saveOutputNote( QString commitment, QString note);
 
     void onSgnWalletBalanceUpdated();
     void onSgnOutputs( QString account, bool showSpent, QString height, QVector<QString> outputs);
+    void onSgnNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, QString totalDifficulty, int connections );
 
     void onSgnNewNotificationMessage(int level, QString message);
 
@@ -66,19 +69,14 @@ private:
 
     QString currentSelectedAccount();
 
-    // return enable state for the buttons
-    void updateShownData();
+    void updateCountLabel();
 
     // return selected account
     QString updateAccountsData();
 
-    int calcPageSize() const;
-
     bool isShowUnspent() const;
 
-    wallet::WalletOutput * getSelectedOutput();
-
-    void showLockedState(int row, const wallet::WalletOutput & output);
+    void setLockedState(const wallet::WalletOutput & output, bool locked);
 
     // return true if user fine with lock changes
     bool showLockMessage();
@@ -89,12 +87,9 @@ private:
     bridge::Wallet * wallet = nullptr;
     bridge::Outputs * outputs = nullptr; // needed as output windows active flag
 
-    QVector<wallet::WalletOutput> allData; // all outputs
-    QVector<wallet::WalletOutput> shownData; // Outputs that we show
-
-    int currentPagePosition = INT_MAX; // position at the paging...
-
-    //QPair<bool,bool> buttonState = QPair<bool,bool>(false, false);
+    OutputsModel * outputsModel = nullptr;
+    OutputsFilterModel * outputsFilter = nullptr;
+    QString account; // Account of the outputs at outputsModel
 
     bool inHodl = false; // If acount enrolled in HODL. Requested once to eliminate race conditions
     bool canLockOutputs = false;
@@ -0,0 +1,248 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "e_transactions_model.h"
+#include "../core/global.h"
+#include "../util/stringutils.h"
+#include <QBrush>
+
+namespace wnd {
+
+static bool isSameTransaction(const wallet::WalletTransaction & a, const wallet::WalletTransaction & b) {
+    return a.txIdx == b.txIdx && a.transactionType == b.transactionType && a.txid == b.txid &&
+           a.address == b.address && a.creationTime == b.creationTime && a.ttlCutoffHeight == b.ttlCutoffHeight &&
+           a.confirmed == b.confirmed && a.height == b.height && a.confirmationTime == b.confirmationTime &&
+           a.numInputs == b.numInputs && a.numOutputs == b.numOutputs && a.credited == b.credited &&
+           a.debited == b.debited && a.fee == b.fee && a.coinNano == b.coinNano && a.proof == b.proof &&
+           a.kernel == b.kernel;
+}
+
+TransactionsModel::TransactionsModel(QObject * parent) :
+    QAbstractTableModel(parent)
+{
+    current = QDateTime::currentDateTime();
+}
+
+TransactionsModel::~TransactionsModel() {}
+
+void TransactionsModel::setTransactions( const QVector<wallet::WalletTransaction> & newTrans ) {
+    current = QDateTime::currentDateTime();
+
+    if (isSearchResults())
+        clear();
+
+    // Normally the list is the same with some updated rows and new transactions at the end.
+    const int oldSz = transactions.size();
+    int common = 0;
+    while ( common<oldSz && common<newTrans.size() && transactions[common].txIdx == newTrans[common].txIdx )
+        common++;
+
+    if (common < oldSz) {
+        // Some transactions are gone or reordered. It is rare, resetting everything
+        beginResetModel();
+        transactions = newTrans;
+        endResetModel();
+        return;
+    }
+
+    for (int i=0; i<common; i++) {
+        if ( !isSameTransaction(transactions[i], newTrans[i]) ) {
+            transactions[i] = newTrans[i];
+            emit dataChanged( index(i,0), index(i, COLUMNS_NUMBER-1) );
+        }
+    }
+
+    if (newTrans.size() > oldSz) {
+        beginInsertRows( QModelIndex(), oldSz, newTrans.size()-1 );
+        for (int i=oldSz; i<newTrans.size(); i++)
+            transactions.push_back(newTrans[i]);
+        endInsertRows();
+    }
+}
+
+void TransactionsModel::clear() {
+    if (transactions.isEmpty() && txAccounts.isEmpty())
+        return;
+
+    beginResetModel();
+    transactions.clear();
+    txAccounts.clear();
+    endResetModel();
+}
+
+void TransactionsModel::setSearchResults( const QVector<QString> & accounts, const QVector<wallet::WalletTransaction> & newTrans ) {
+    Q_ASSERT(accounts.size() == newTrans.size());
+    current = QDateTime::currentDateTime();
+
+    // Results are different every time, no reasons to merge them
+    beginResetModel();
+    transactions = newTrans;
+    txAccounts = accounts;
+    endResetModel();
+}
+
+QString TransactionsModel::getAccount(int row) const {
+    if (row<0 || row>=txAccounts.size())
+        return "";
+    return txAccounts[row];
+}
+
+const wallet::WalletTransaction * TransactionsModel::getTransaction(int row) const {
+    if (row<0 || row>=transactions.size())
+        return nullptr;
+    return &transactions[row];
+}
+
+void TransactionsModel::setNodeHeight(int64_t height) {
+    if (nodeHeight == height)
+        return;
+    nodeHeight = height;
+    // Only confirmation column depends on the height
+    if (!transactions.isEmpty())
+        emit dataChanged( index(0,COL_CONFIRM), index(transactions.size()-1,COL_CONFIRM) );
+}
+
+void TransactionsModel::setConfirmNumber(int _confirmNumber) {
+    if (confirmNumber == _confirmNumber)
+        return;
+    confirmNumber = _confirmNumber;
+    if (!transactions.isEmpty())
+        emit dataChanged( index(0,COL_CONFIRM), index(transactions.size()-1,COL_CONFIRM) );
+}
+
+int TransactionsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : transactions.size();
+}
+
+int TransactionsModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : COLUMNS_NUMBER;
+}
+
+QVariant TransactionsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row()>=transactions.size() || index.column()>=COLUMNS_NUMBER)
+        return QVariant();
+
+    const wallet::WalletTransaction & trans = transactions[index.row()];
+
+    switch (role) {
+        case Qt::DisplayRole:
+            // Search results are from different accounts
+            if (index.column() == COL_IDX && isSearchResults())
+                return txAccounts[index.row()] + " " + getCellText(trans, index.column());
+            return getCellText(trans, index.column());
+        case Qt::TextAlignmentRole:
+            return int(Qt::AlignCenter);
+        case Qt::BackgroundRole:
+            return getBackground(trans);
+        case SortRole:
+            return getSortValue(trans, index.row(), index.column());
+        default:
+            return QVariant();
+    }
+}
+
+QVariant TransactionsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QVariant();
+
+    switch (section) {
+        case COL_IDX:     return "#";
+        case COL_TYPE:    return "TYPE";
+        case COL_TXID:    return "ID";
+        case COL_ADDRESS: return "ADDRESS";
+        case COL_TIME:    return "TIME";
+        case COL_AMOUNT:  return "MWC";
+        case COL_CONFIRM: return "CONFIRM";
+        case COL_HEIGHT:  return "HEIGHT";
+        default:          return QVariant();
+    }
+}
+
+// Return -1 if confirmations number is unknown
+int64_t TransactionsModel::getConfirmations(const wallet::WalletTransaction & trans) const {
+    // nodeHeight will be 0 if the node is offline or out of sync
+    if (nodeHeight > 0 && trans.height > 0) {
+        // confirmations are 1 more than the difference between the node and transaction heights
+        return nodeHeight - trans.height + 1;
+    }
+    return -1;
+}
+
+QString TransactionsModel::getCellText(const wallet::WalletTransaction & trans, int column) const {
+    switch (column) {
+        case COL_IDX:     return trans.txIdx<0 ? "" : QString::number( trans.txIdx+1 ); // Pending receive doesn't have index yet
+        case COL_TYPE:    return trans.getTypeAsStr();
+        case COL_TXID:    return trans.txid;
+        case COL_ADDRESS: return trans.address;
+        case COL_TIME:    return trans.creationTime;
+        case COL_AMOUNT:  return util::nano2one(trans.coinNano);
+        case COL_CONFIRM: {
+            int64_t confirmations = getConfirmations(trans);
+            // if the node is online and in sync, display the number of confirmations instead
+            if (confirmations < 0)
+                return trans.confirmed ? "YES" : "NO";
+
+            QString transConfirmedStr = QString::number(confirmations);
+            int needConfirms = trans.isCoinbase() ? mwc::COIN_BASE_CONFIRM_NUMBER : confirmNumber;
+            if (needConfirms >= confirmations) {
+                transConfirmedStr += "/" + QString::number(needConfirms);
+            }
+            return transConfirmedStr;
+        }
+        case COL_HEIGHT:  return trans.height<=0 ? "" : QString::number(trans.height);
+        default:          return "";
+    }
+}
+
+QVariant TransactionsModel::getSortValue(const wallet::WalletTransaction & trans, int row, int column) const {
+    switch (column) {
+        case COL_IDX:
+        case COL_TIME:
+            // Search results are sorted by time already
+            if (isSearchResults())
+                return -row;
+            return qlonglong(trans.txIdx); // Transactions are created in txIdx order, no need to parse the time
+        case COL_AMOUNT:  return qlonglong(trans.coinNano);
+        case COL_CONFIRM: {
+            int64_t confirmations = getConfirmations(trans);
+            if (confirmations < 0)
+                confirmations = trans.confirmed ? 1 : 0;
+            return qlonglong(confirmations);
+        }
+        case COL_HEIGHT:  return qlonglong(trans.height);
+        default:          return getCellText(trans, column);
+    }
+}
+
+QVariant TransactionsModel::getBackground(const wallet::WalletTransaction & trans) const {
+    if ( !trans.canBeCancelled() )
+        return QVariant();
+
+    int64_t age = trans.calculateTransactionAge(current);
+    // 1 hours is a 1.0
+    double selection = age > 60 * 60 ?
+                1.0 : (double(age) / double(60 * 60));
+    if (selection <= 0.0)
+        return QVariant();
+
+    // Calculating the gradient
+    QColor clr;
+    clr.setRgbF( selectedLow.redF() * (1.0-selection) + selectedHi.redF() * selection,
+                 selectedLow.greenF() * (1.0-selection) + selectedHi.greenF() * selection,
+                 selectedLow.blueF() * (1.0-selection) + selectedHi.blueF() * selection,
+                 selectedLow.alphaF() * (1.0-selection) + selectedHi.alphaF() * selection );
+    return QBrush(clr);
+}
+
+}
@@ -0,0 +1,85 @@
+// Copyright 2020 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_E_TRANSACTIONS_MODEL_H
+#define MWC_QT_WALLET_E_TRANSACTIONS_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QDateTime>
+#include <QColor>
+#include "../wallet/wallet.h"
+
+namespace wnd {
+
+// Transactions of a single account for the transactions page.
+// Cells text is built on request, so only visible rows are materialized.
+class TransactionsModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum COLUMN {COL_IDX=0, COL_TYPE, COL_TXID, COL_ADDRESS, COL_TIME, COL_AMOUNT, COL_CONFIRM, COL_HEIGHT, COLUMNS_NUMBER};
+
+    // Role for the sort proxy. Numeric for the number columns
+    static const int SortRole = Qt::UserRole;
+
+    explicit TransactionsModel(QObject * parent);
+    virtual ~TransactionsModel() override;
+
+    // Update the transactions. Rows are matched by txIdx, only changed and new rows are reported to the view.
+    // Note: txIdx is unique for the account only. Call clear() before switching to another account.
+    void setTransactions( const QVector<wallet::WalletTransaction> & transactions );
+    void clear();
+
+    // Show search results from different accounts. accounts - account for every transaction
+    void setSearchResults( const QVector<QString> & accounts, const QVector<wallet::WalletTransaction> & transactions );
+    bool isSearchResults() const {return !txAccounts.isEmpty();}
+
+    const QVector<wallet::WalletTransaction> & getTransactions() const {return transactions;}
+    // Return null for invalid row
+    const wallet::WalletTransaction * getTransaction(int row) const;
+    // Account of the search result. Empty string if it is not a search result
+    QString getAccount(int row) const;
+
+    // Confirmations are calculated from the node height. height<=0 - node is offline or not synced
+    void setNodeHeight(int64_t height);
+    void setConfirmNumber(int confirmNumber);
+
+    // Colors for not finalized transactions. Color depends on transaction age
+    void setHightlightColors(QColor low, QColor hi) {selectedLow=low; selectedHi=hi;}
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QString getCellText(const wallet::WalletTransaction & trans, int column) const;
+    QVariant getSortValue(const wallet::WalletTransaction & trans, int row, int column) const;
+    QVariant getBackground(const wallet::WalletTransaction & trans) const;
+    int64_t getConfirmations(const wallet::WalletTransaction & trans) const;
+
+private:
+    QVector<wallet::WalletTransaction> transactions;
+    QVector<QString> txAccounts; // Accounts for the search results, empty for a single account data
+
+    int64_t nodeHeight = 0;
+    int     confirmNumber = 10;
+    QDateTime current; // Age of transactions is calculated for this moment. Updated with the data
+
+    QColor selectedLow = QColor(0,0,0,0);
+    QColor selectedHi = QColor(0,0,0,0);
+};
+
+}
+
+#endif //MWC_QT_WALLET_E_TRANSACTIONS_MODEL_H
@@ -14,7 +14,9 @@
 
 #include "e_transactions_w.h"
 #include "ui_e_transactions.h"
+#include "e_transactions_model.h"
 #include <QFileDialog>
+#include <QSortFilterProxyModel>
 #include "../control_desktop/messagebox.h"
 #include "../util_desktop/timeoutlock.h"
 #include <QDebug>
@@ -25,9 +27,6 @@
 #include "../bridge/wnd/e_transactions_b.h"
 #include "../core/global.h"
 
-// It is exception for Mobile, CSV export not likely needed into mobile wallet
-#include "../util/Files.h"
-
 namespace wnd {
 
 Transactions::Transactions(QWidget *parent) :
@@ -56,21 +55,42 @@ Transactions::Transactions(QWidget *parent) :
                       this, &Transactions::onSgnNodeStatus, Qt::QueuedConnection);
     QObject::connect( wallet, &bridge::Wallet::sgnNewNotificationMessage,
                       this, &Transactions::onSgnNewNotificationMessage, Qt::QueuedConnection);
-
-    ui->transactionTable->setHightlightColors(QColor(255,255,255,51), QColor(255,255,255,153) ); // Alpha: 0.2  - 0.6
+    QObject::connect( transaction, &bridge::Transactions::sgnExportProgress,
+                      this, &Transactions::onSgnExportProgress, Qt::QueuedConnection);
+    QObject::connect( transaction, &bridge::Transactions::sgnExportFinished,
+                      this, &Transactions::onSgnExportFinished, Qt::QueuedConnection);
+
+    transModel = new TransactionsModel(this);
+    transModel->setHightlightColors(QColor(255,255,255,51), QColor(255,255,255,153) ); // Alpha: 0.2  - 0.6
+    transModel->setConfirmNumber( config->getInputConfirmationNumber() );
+
+    transProxy = new QSortFilterProxyModel(this);
+    transProxy->setSourceModel(transModel);
+    transProxy->setSortRole(TransactionsModel::SortRole);
+    transProxy->setDynamicSortFilter(true);
+
+    ui->transactionTable->setModel(transProxy);
+    // Newest transactions first
+    ui->transactionTable->setSortingEnabled(true);
+    ui->transactionTable->sortByColumn(TransactionsModel::COL_IDX, Qt::DescendingOrder);
     // Alpha delta for row stripe coloring. Range 0-255
     ui->transactionTable->setStripeAlfaDelta( 5 ); // very small number
 
+    QObject::connect( ui->transactionTable, &TableWithColumns::sgnSelectionChanged,
+                      this, &Transactions::onTransactionSelectionChanged, Qt::DirectConnection);
+
     ui->progress->initLoader(true);
     ui->progressFrame->hide();
 
     initTableHeaders();
 
+    // Export might be started from the previous instance of this window
+    if (transaction->isExportRunning())
+        exportStatus = "Exporting...";
+    updateExportButton();
+
     onSgnWalletBalanceUpdated();
     requestTransactions();
-
-    updateData();
-
 }
 
 Transactions::~Transactions()
@@ -97,131 +117,61 @@ void Transactions::saveTableHeaders() {
     config->updateColumnsWidhts("TransTblColWidth", ui->transactionTable->getColumnWidths());
 }
 
-int Transactions::calcPageSize() const {
-    QSize sz1 = ui->transactionTable->size();
-    QSize sz2 = ui->progressFrame->size();
-
-    return ListWithColumns::getNumberOfVisibleRows( std::max(sz1.height(), sz2.height()) );
-}
-
-void Transactions::on_prevBtn_clicked()
-{
-    if (currentPagePosition > 0) {
-        int pageSize = calcPageSize();
-        currentPagePosition = std::max( 0, currentPagePosition-pageSize );
-        updateData();
-    }
-}
-
-void Transactions::on_nextBtn_clicked()
-{
-    if (currentPagePosition + shownTrans.size() < allTrans.size()) {
-        int pageSize = calcPageSize();
-        currentPagePosition = std::min( allTrans.size()-pageSize, currentPagePosition+pageSize );
-        updateData();
-    }
-}
-
-void Transactions::updateData() {
-    ui->nextBtn->setEnabled(false);
-    ui->prevBtn->setEnabled(false);
-    shownTrans.clear();
-    ui->transactionTable->clearData();
-    int pageSize = calcPageSize();
-
-    updateButtons();
-
-    if (currentPagePosition <0 || allTrans.size()<=0 || pageSize<=0) {
-        ui->pageLabel->setText("");
-        return;
-    }
-    else {
-        int total = allTrans.size();
-        // Updating page status
-        if (total <= 1) {
-            ui->pageLabel->setText( QString::number(total) +
-                                    " of " + QString::number( total) );
-        }
-        else {
-            ui->pageLabel->setText( QString::number(currentPagePosition+1) + "-" + QString::number( std::min(currentPagePosition+pageSize-1+1, total) ) +
-                                " of " + QString::number( total) );
+void Transactions::updateCountLabel() {
+    int total = transModel->rowCount();
+    ui->pageLabel->setToolTip("");
+    if (!exportStatus.isEmpty())
+        ui->pageLabel->setText(exportStatus);
+    else if (transModel->isSearchResults()) {
+        QString label = QString::number(total) + " found";
+        QVector<QString> notIndexed = transaction->getNotIndexedAccounts();
+        if (!notIndexed.isEmpty()) {
+            label += ", indexing " + QString::number(notIndexed.size()) + (notIndexed.size()==1 ? " account" : " accounts");
+            ui->pageLabel->setToolTip("Search doesn't cover these accounts yet: " + QStringList(notIndexed.toList()).join(", "));
         }
-        ui->nextBtn->setEnabled(currentPagePosition < total-pageSize);
-        ui->prevBtn->setEnabled(currentPagePosition>0);
-
-        // Updating tx table data
-        shownTrans.clear();
-        for (int i=currentPagePosition; i<allTrans.size() && pageSize>0; i++, pageSize-- ) {
-            shownTrans.push_back(allTrans[i]);
-        }
-
-        QDateTime current = QDateTime::currentDateTime();
-
-        ui->transactionTable->clearData();
-
-        int expectedConfirmNumber = config->getInputConfirmationNumber();
-
-        for ( int idx = shownTrans.size()-1; idx>=0; idx--) {
-            const wallet::WalletTransaction trans = shownTrans[idx];
-
-            double selection = 0.0;
-
-            if ( trans.canBeCancelled() ) {
-                int64_t age = trans.calculateTransactionAge(current);
-                // 1 hours is a 1.0
-                selection = age > 60 * 60 ?
-                            1.0 : (double(age) / double(60 * 60));
-            }
-
-            QString transConfirmedStr = trans.confirmed ? "YES" : "NO";
-            // if the node is online and in sync, display the number of confirmations instead
-            // nodeHeight will be 0 if the node is offline or out of sync
-            if (nodeHeight > 0 && trans.height > 0) {
-                int needConfirms = trans.isCoinbase() ? mwc::COIN_BASE_CONFIRM_NUMBER : expectedConfirmNumber;
-                // confirmations are 1 more than the difference between the node and transaction heights
-                int64_t confirmations = nodeHeight - trans.height + 1;
-                transConfirmedStr = QString::number(confirmations);
-                if (needConfirms >= confirmations) {
-                    transConfirmedStr += "/" + QString::number(needConfirms);
-                }
-            }
-
-            ui->transactionTable->appendRow( QVector<QString>{
-                    QString::number(  trans.txIdx+1 ),
-                    trans.getTypeAsStr(),
-                    trans.txid,
-                    trans.address,
-                    trans.creationTime,
-                    util::nano2one(trans.coinNano),
-                    transConfirmedStr,
-                    trans.height<=0 ? "" : QString::number(trans.height)
-            }, selection );
-        }
-
+        ui->pageLabel->setText(label);
     }
+    else if (total <= 0)
+        ui->pageLabel->setText("");
+    else
+        ui->pageLabel->setText( QString::number(total) + (total==1 ? " transaction" : " transactions") );
 }
 
 void Transactions::onSgnTransactions( QString acc, QString height, QVector<QString> transactions) {
     Q_UNUSED(height)
 
-    if (acc != ui->accountComboBox->currentData().toString() )
+    const bool currentAccount = acc == ui->accountComboBox->currentData().toString();
+    if (currentAccount) {
+        ui->progressFrame->hide();
+        ui->transactionTable->show();
+    }
+
+    // Transactions index is already updated, search results might be changed. Any account can be in the results.
+    if (isSearchMode()) {
+        updateSearchResults();
         return;
+    }
 
-    ui->progressFrame->hide();
-    ui->transactionTable->show();
+    if (!currentAccount)
+        return;
 
-    account = acc;
-    shownTrans.clear();
-    allTrans.clear();
+    // txIdx is unique for the account only, model can't merge transactions from different accounts
+    if (account != acc) {
+        transModel->clear();
+        account = acc;
+    }
 
+    QVector<wallet::WalletTransaction> trans;
+    trans.reserve(transactions.size());
     for (QString & t : transactions ) {
-        allTrans.push_back( wallet::WalletTransaction::fromJson(t) );
+        trans.push_back( wallet::WalletTransaction::fromJson(t) );
     }
 
-    int pageSize = calcPageSize();
-    currentPagePosition = std::max(0, allTrans.size() - pageSize);
+    // Only changed rows will be updated, selection and scroll position stay
+    transModel->setTransactions(trans);
 
-    updateData();
+    updateCountLabel();
+    updateButtons();
 }
 
 void Transactions::onSgnExportProofResult(bool success, QString fn, QString msg ) {
@@ -261,44 +211,100 @@ void Transactions::onSgnVerifyProofResult(bool success, QString fn, QString msg
 
 
 void Transactions::requestTransactions() {
-    allTrans.clear();
-    shownTrans.clear();
-    nodeHeight = -1;
-    currentPagePosition = 0;
+    transModel->setNodeHeight(-1);
+    transModel->setConfirmNumber( config->getInputConfirmationNumber() );
 
     QString account = ui->accountComboBox->currentData().toString();
-    if (account.isEmpty())
+    if (account.isEmpty()) {
+        transModel->clear();
+        this->account = "";
+        updateCountLabel();
+        updateButtons();
         return;
+    }
 
     ui->progressFrame->show();
     ui->transactionTable->hide();
-    ui->transactionTable->clearData();
 
     // !!! Note, order is important even it is async. We want node status be processed first..
     wallet->requestNodeStatus(); // Need to know th height.
     wallet->requestTransactions(account, true);
-    updateData();
+    updateButtons();
 }
 
 // return null if nothing was selected
-wallet::WalletTransaction * Transactions::getSelectedTransaction() {
-    int row = ui->transactionTable->getSelectedRow();
-    if (row<0 || row>=shownTrans.size())
-        return nullptr;
+const wallet::WalletTransaction * Transactions::getSelectedTransaction() const {
+    return transModel->getTransaction( ui->transactionTable->getSelectedRow() );
+}
 
-    return &shownTrans[ shownTrans.size()-1-row ];
+QString Transactions::getSelectedAccount() const {
+    if (transModel->isSearchResults())
+        return transModel->getAccount( ui->transactionTable->getSelectedRow() );
+    return account;
 }
 
 void Transactions::updateButtons() {
-    wallet::WalletTransaction * selected = getSelectedTransaction();
+    const wallet::WalletTransaction * selected = getSelectedTransaction();
+    // Proof and cancel are working with the current account only, search results can be from others.
+    // Pending receive from the search index doesn't have index yet
+    bool canProcess = selected!=nullptr && selected->txIdx>=0 &&
+            getSelectedAccount() == ui->accountComboBox->currentData().toString();
+
+    ui->generateProofButton->setEnabled( canProcess && selected->proof );
+    ui->deleteButton->setEnabled( canProcess && selected->canBeCancelled() );
+}
 
-    ui->generateProofButton->setEnabled( selected!=nullptr && selected->proof );
-    ui->deleteButton->setEnabled( selected!=nullptr && selected->canBeCancelled() );
+bool Transactions::isSearchMode() const {
+    return !ui->searchEdit->text().trimmed().isEmpty();
+}
+
+void Transactions::on_searchEdit_textChanged(const QString &text)
+{
+    Q_UNUSED(text)
+    if (isSearchMode()) {
+        updateSearchResults();
+    }
+    else {
+        // Back to the account transactions
+        transModel->clear();
+        account = "";
+        requestTransactions();
+    }
+}
+
+void Transactions::updateSearchResults() {
+    // Search is done with the index, it is fast enough to do it on every key press
+    // Result: [error message, account, transaction json, account, transaction json, ...]
+    QVector<QString> result = transaction->searchTransactions( ui->searchEdit->text().trimmed() );
+    if (result.isEmpty())
+        return;
+
+    if (!result[0].isEmpty()) {
+        ui->pageLabel->setText("Invalid search");
+        ui->pageLabel->setToolTip(result[0]);
+        return;
+    }
+
+    QVector<QString> accounts;
+    QVector<wallet::WalletTransaction> trans;
+    for (int i=2; i<result.size(); i+=2) {
+        accounts.push_back(result[i-1]);
+        trans.push_back( wallet::WalletTransaction::fromJson(result[i]) );
+    }
+
+    account = "";
+    transModel->setSearchResults(accounts, trans);
+
+    updateCountLabel();
+    updateButtons();
 }
 
 void Transactions::on_refreshButton_clicked()
 {
-    requestTransactions();
+    if (isSearchMode())
+        updateSearchResults();
+    else
+        requestTransactions();
 }
 
 void Transactions::on_validateProofButton_clicked()
@@ -329,7 +335,7 @@ void Transactions::on_generateProofButton_clicked()
 {
     util::TimeoutLockObject to( "Transactions" );
 
-    wallet::WalletTransaction * selected = getSelectedTransaction();
+    const wallet::WalletTransaction * selected = getSelectedTransaction();
 
     if (! ( selected!=nullptr && selected->proof ) ) {
         control::MessageBox::messageText(this, "Need info",
@@ -362,11 +368,17 @@ void Transactions::on_generateProofButton_clicked()
 
 void Transactions::on_exportButton_clicked()
 {
+    if (transaction->isExportRunning()) {
+        transaction->cancelExport();
+        return;
+    }
+
     util::TimeoutLockObject to( "Transactions" );
 
+    QString selectedFilter;
     QString fileName = QFileDialog::getSaveFileName(this, tr("Export Transactions"),
                                                     config->getPathFor("TxExportCsv"),
-                                                    tr("Export Options (*.csv)"));
+                                                    tr("CSV (*.csv);;JSON lines (*.jsonl)"), &selectedFilter);
 
     if (fileName.length()==0)
         return;
@@ -376,56 +388,82 @@ void Transactions::on_exportButton_clicked()
 
     // check to ensure a file extension was specified as getSaveFileName
     // allows files without an extension to be specified
-    if (!fileName.endsWith(".csv", Qt::CaseInsensitive))
-    {
+    bool jsonLines = fileName.endsWith(".jsonl", Qt::CaseInsensitive) ||
+            (!fileName.endsWith(".csv", Qt::CaseInsensitive) && selectedFilter.contains(".jsonl"));
+    if (jsonLines) {
+        if (!fileName.endsWith(".jsonl", Qt::CaseInsensitive))
+            fileName += ".jsonl";
+    }
+    else if (!fileName.endsWith(".csv", Qt::CaseInsensitive)) {
         // if no file extension is specified, default to exporting CSV files
         fileName += ".csv";
     }
 
-    if (allTrans.isEmpty()) {
-        control::MessageBox::messageText(this, "Export Error", "You don't have any transactions to export.");
+    QString exportAccount = ui->accountComboBox->currentData().toString();
+    if ( ui->accountComboBox->count() > 1 &&
+         core::WndManager::RETURN_CODE::BTN2 == control::MessageBox::questionText(this, "Export Transactions",
+                "Do you want to export transactions for account '" + exportAccount + "' or for all accounts?",
+                "Current account", "All accounts",
+                "Export transactions for account '" + exportAccount + "' only",
+                "Export transactions for all accounts. Account name will be added to every record",
+                true, false) ) {
+        exportAccount = "";
+    }
+
+    // Export is done at the background, data is written as it comes from mwc713.
+    QString error = transaction->exportTransactions(fileName, jsonLines, exportAccount);
+    if (!error.isEmpty()) {
+        control::MessageBox::messageText(this, "Export Error", error);
         return;
     }
 
-    // qt-wallet displays the transactions last to first
-    // however when exporting the transactions, we want to export first to last
-    QStringList exportRecords;
-
-    // retrieve the first transaction and get the CSV headers
-    wallet::WalletTransaction trans = allTrans[0];
-    QString csvHeaders = trans.getCSVHeaders();
-    exportRecords << csvHeaders;
-    QString csvValues = trans.toStringCSV();
-    exportRecords << csvValues;
-
-    // now retrieve the remaining transactions and add them to our list
-    for ( int idx=1; idx < allTrans.size(); idx++) {
-        wallet::WalletTransaction trans = allTrans[idx];
-        QString csvValues = trans.toStringCSV();
-        exportRecords << csvValues;
-    }
-    // Note: Mobile doesn't expect to export anything. That is why we are breaking bridge rule here and usung util::writeTextFile directly
-    // warning: When using a debug build, avoid testing with an existing file which has
-    //          read-only permissions. writeTextFile will hit a Q_ASSERT causing qt-wallet
-    //          to crash.
-    bool exportOk = util::writeTextFile(fileName, exportRecords);
-    if (!exportOk)
-    {
-        control::MessageBox::messageText(this, "Error", "Export unable to write to file: " + fileName);
+    exportStatus = "Exporting...";
+    updateCountLabel();
+    updateExportButton();
+}
+
+void Transactions::onSgnExportProgress( int accountsDone, int accountsNum, QString records ) {
+    exportStatus = "Exporting: " + records + " transactions";
+    if (accountsNum>1)
+        exportStatus += ", " + QString::number(accountsDone) + " of " + QString::number(accountsNum) + " accounts";
+    updateCountLabel();
+}
+
+void Transactions::onSgnExportFinished( bool success, bool cancelled, QString fileName, QString message, QString records ) {
+    exportStatus = "";
+    updateCountLabel();
+    updateExportButton();
+
+    if (cancelled) {
+        // Cancelled by the user - nothing to report. Stopped by the wallet - not an error, just let the user know.
+        if (!message.isEmpty())
+            control::MessageBox::messageText(this, "Export cancelled", message);
     }
-    else
-    {
+    else if (success) {
         // some users may have a large number of transactions which take time to write to the file
         // so indicate when the file write has completed
-        control::MessageBox::messageText(this, "Success", "Exported transactions to file: " + fileName);
+        control::MessageBox::messageText(this, "Success", "Exported " + records + " transactions to file: " + fileName);
+    }
+    else {
+        control::MessageBox::messageText(this, "Export Error", message);
+    }
+}
+
+void Transactions::updateExportButton() {
+    if (transaction->isExportRunning()) {
+        ui->exportButton->setText("Cancel Export");
+        ui->exportButton->setToolTip("Stop the running export. Partially exported file will be deleted.");
+    }
+    else {
+        ui->exportButton->setText("Export");
+        ui->exportButton->setToolTip("Allows you to export the transactions to a .CSV or JSON lines file.");
     }
-    return;
 }
 
-void Transactions::on_transactionTable_itemSelectionChanged()
+void Transactions::onTransactionSelectionChanged()
 {
-    wallet::WalletTransaction * selected = getSelectedTransaction();
-    if(selected!=nullptr) {
+    const wallet::WalletTransaction * selected = getSelectedTransaction();
+    if(selected!=nullptr && getSelectedAccount() == ui->accountComboBox->currentData().toString()) {
 
         if(selected->transactionType == wallet::WalletTransaction::TRANSACTION_TYPE::SEND &&
            !selected->confirmed) {
@@ -439,15 +477,14 @@ void Transactions::on_transactionTable_itemSelectionChanged()
     updateButtons();
 }
 
-void Transactions::on_transactionTable_cellDoubleClicked(int row, int column)
+void Transactions::on_transactionTable_doubleClicked(const QModelIndex &index)
 {
-    Q_UNUSED(row);
-    Q_UNUSED(column);
+    const int row = ui->transactionTable->mapToSourceRow(index);
+    const wallet::WalletTransaction * selected = transModel->getTransaction(row);
+    QString account = transModel->isSearchResults() ? transModel->getAccount(row) :
+                                                      ui->accountComboBox->currentData().toString();
 
-    wallet::WalletTransaction * selected = getSelectedTransaction();
-    QString account = ui->accountComboBox->currentData().toString();
-
-    if (account.isEmpty() || selected==nullptr)
+    if (account.isEmpty() || selected==nullptr || selected->txIdx<0)
         return;
 
     // respond will come at updateTransactionById
@@ -464,7 +501,7 @@ void Transactions::onSgnNodeStatus( bool online, QString errMsg, int _nodeHeight
     Q_UNUSED(connections);
 
     if (online)
-        nodeHeight = _nodeHeight;
+        transModel->setNodeHeight(_nodeHeight);
 }
 
 void Transactions::onSgnTransactionById(bool success, QString account, QString height, QString transactionJson,
@@ -503,13 +540,16 @@ void Transactions::on_accountComboBox_activated(int index)
     QString account = ui->accountComboBox->currentData().toString();
     if (!account.isEmpty())
         wallet->switchAccount(account);
-    requestTransactions();
+    if (isSearchMode())
+        ui->searchEdit->clear(); // Will request transactions for the account
+    else
+        requestTransactions();
 }
 
 void Transactions::on_deleteButton_clicked()
 {
     util::TimeoutLockObject to( "Transactions" );
-    wallet::WalletTransaction * selected = getSelectedTransaction();
+    const wallet::WalletTransaction * selected = getSelectedTransaction();
 
     if (! ( selected!=nullptr && !selected->confirmed ) ) {
         control::MessageBox::messageText(this, "Need info",
@@ -518,6 +558,7 @@ void Transactions::on_deleteButton_clicked()
     }
 
     wallet::WalletTransaction tx2del = *selected;
+    QString txAccount = getSelectedAccount();
 
     if ( control::MessageBox::questionText(this, "Transaction cancellation",
             "Are you sure you want to cancel transaction #" + QString::number(tx2del.txIdx+1) +
@@ -527,7 +568,7 @@ void Transactions::on_deleteButton_clicked()
                                "Continue and cancel the transaction, I am not expecting it to be finalized",
                                true, false) == core::WndManager::RETURN_CODE::BTN2 ) {
 
-        wallet->requestCancelTransacton( account, QString::number(tx2del.txIdx));
+        wallet->requestCancelTransacton( txAccount, QString::number(tx2del.txIdx));
     }
 }
 
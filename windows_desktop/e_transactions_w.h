@@ -18,6 +18,8 @@
 #include "../core_desktop/navwnd.h"
 #include "../wallet/wallet.h"
 
+class QSortFilterProxyModel;
+
 namespace Ui {
 class Transactions;
 }
@@ -30,6 +32,8 @@ class Transactions;
 
 namespace wnd {
 
+class TransactionsModel;
+
 class Transactions : public core::NavWnd
 {
     Q_OBJECT
@@ -39,8 +43,8 @@ public:
     ~Transactions();
 
 private slots:
-    void on_transactionTable_itemSelectionChanged();
-    void on_transactionTable_cellDoubleClicked(int row, int column);
+    void onTransactionSelectionChanged();
+    void on_transactionTable_doubleClicked(const QModelIndex &index);
 
     void on_accountComboBox_activated(int index);
 
@@ -49,8 +53,7 @@ private slots:
     void on_generateProofButton_clicked();
     void on_exportButton_clicked();
     void on_deleteButton_clicked();
-    void on_prevBtn_clicked();
-    void on_nextBtn_clicked();
+    void on_searchEdit_textChanged(const QString &text);
 
     void onSgnWalletBalanceUpdated();
     void onSgnTransactions( QString account, QString height, QVector<QString> transactions);
@@ -62,34 +65,40 @@ private slots:
     void onSgnExportProofResult(bool success, QString fn, QString msg );
     void onSgnVerifyProofResult(bool success, QString fn, QString msg );
 
+    void onSgnExportProgress( int accountsDone, int accountsNum, QString records );
+    void onSgnExportFinished( bool success, bool cancelled, QString fileName, QString message, QString records );
+
     void onSgnNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, QString totalDifficulty, int connections );
     void onSgnNewNotificationMessage(int level, QString message); // level: notify::MESSAGE_LEVEL values
 
     void saveTransactionNote(QString txUuid, QString note);
 private:
     // return null if nothing was selected
-    wallet::WalletTransaction * getSelectedTransaction();
+    const wallet::WalletTransaction * getSelectedTransaction() const;
+    // Account of the selected transaction. Search results can be from any account
+    QString getSelectedAccount() const;
+
+    bool isSearchMode() const;
+    void updateSearchResults();
 
     void requestTransactions();
     void updateButtons();
-    void updateData();
+    void updateCountLabel();
+    void updateExportButton();
 
     void initTableHeaders();
     void saveTableHeaders();
-
-    int calcPageSize() const;
 private:
     Ui::Transactions *ui;
     bridge::Config * config = nullptr;
     bridge::Wallet * wallet = nullptr;
     bridge::Transactions * transaction = nullptr; // just a placeholder to signal that this window is online
 
-    QString account;
-    QVector<wallet::WalletTransaction> allTrans;
-    QVector<wallet::WalletTransaction> shownTrans;
+    TransactionsModel * transModel = nullptr;
+    QSortFilterProxyModel * transProxy = nullptr;
 
-    int currentPagePosition = 0; // position at the paging...
-    int64_t nodeHeight    = 0;
+    QString account; // Account of the transactions at transModel. Empty for search results
+    QString exportStatus; // Export progress, shown instead of transactions counter
 };
 
 }
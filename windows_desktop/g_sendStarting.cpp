@@ -85,6 +85,8 @@ void SendStarting::onSgnWalletBalanceUpdated() {
     ui->accountComboBox->setCurrentIndex(selectedAccIdx);
 
     ui->progress->hide();
+    // Spendable outputs might change
+    updateFeeEstimate();
 }
 
 void SendStarting::onChecked(int id) {
@@ -140,6 +142,23 @@ void SendStarting::on_accountComboBox_currentIndexChanged(int index)
         return;
 
     wallet->switchAccount(account);
+    updateFeeEstimate();
+}
+
+void SendStarting::on_amountEdit_textChanged(const QString &text) {
+    Q_UNUSED(text)
+    updateFeeEstimate();
+}
+
+// Fee estimation is cheap, it is fine to do it on every change
+void SendStarting::updateFeeEstimate() {
+    QString account = ui->accountComboBox->currentData().toString();
+    QString sendAmount = ui->amountEdit->text().trimmed();
+    QString feeLabel;
+    if (!account.isEmpty() && !sendAmount.isEmpty())
+        feeLabel = send->getTxnFeeEstimateLabel(account, sendAmount);
+
+    ui->feeLabel->setText( feeLabel );
 }
 
 }
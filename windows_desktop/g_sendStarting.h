@@ -44,9 +44,12 @@ private slots:
     void on_nextButton_clicked();
     void on_allAmountButton_clicked();
     void on_accountComboBox_currentIndexChanged(int index);
+    void on_amountEdit_textChanged(const QString &text);
 
     void onSgnWalletBalanceUpdated();
 private:
+    void updateFeeEstimate();
+
     Ui::SendStarting *ui;
     bridge::Wallet * wallet = nullptr;
     bridge::Config * config = nullptr;
@@ -62,8 +62,10 @@ NodeInfo::NodeInfo(QWidget *parent) :
 
     connectionType = wallet::MwcNodeConnection::fromJson(nodeInfo->getNodeConnection()).connectionType;
 
-    if (connectionType == wallet::MwcNodeConnection::NODE_CONNECTION_TYPE::LOCAL)
+    if (connectionType == wallet::MwcNodeConnection::NODE_CONNECTION_TYPE::LOCAL) {
         ui->statusInfo->setText( toBoldAndYellow( nodeInfo->getMwcNodeStatus() ) );
+        ui->statusInfo->setToolTip( nodeInfo->getMwcNodeSyncHistory() );
+    }
 
     ui->showLogsButton->setEnabled( connectionType == wallet::MwcNodeConnection::NODE_CONNECTION_TYPE::LOCAL );
 
@@ -87,8 +89,11 @@ NodeInfo::~NodeInfo() {
 
 // logs to show, multi like output
 void NodeInfo::onSgnUpdateEmbeddedMwcNodeStatus( QString status ) {
-    if (connectionType == wallet::MwcNodeConnection::NODE_CONNECTION_TYPE::LOCAL)
+    if (connectionType == wallet::MwcNodeConnection::NODE_CONNECTION_TYPE::LOCAL) {
         ui->statusInfo->setText( toBoldAndYellow(status) );
+        // Sync phases timing, so it is visible what is slow on this hardware
+        ui->statusInfo->setToolTip( nodeInfo->getMwcNodeSyncHistory() );
+    }
 }
 
 // Empty string to hide warning...
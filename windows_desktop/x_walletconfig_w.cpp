@@ -21,6 +21,7 @@
 #include <QStandardPaths>
 #include "../util_desktop/timeoutlock.h"
 #include "../dialogs_desktop/networkselectiondlg.h"
+#include "../dialogs_desktop/x_walletdiagnostics.h"
 #include "../bridge/wnd/x_walletconfig_b.h"
 #include "../bridge/util_b.h"
 #include "../bridge/config_b.h"
@@ -537,6 +538,14 @@ void WalletConfig::on_logsEnableBtn_clicked()
     updateButtons();
 }
 
+void WalletConfig::on_diagnosticsButton_clicked()
+{
+    util::TimeoutLockObject to("WalletConfig");
+
+    dlg::WalletDiagnostics diagnosticsDlg(this);
+    diagnosticsDlg.exec();
+}
+
 void WalletConfig::updateLogsStateUI(bool enabled) {
     ui->logsEnableBtn->setText( enabled ? "Enabled" : "Disabled" );
     ui->logsEnableBtn->setChecked(enabled);
@@ -46,6 +46,7 @@ private slots:
 
     void on_mwcmqHost_textEdited(const QString &arg1);
     void on_logsEnableBtn_clicked();
+    void on_diagnosticsButton_clicked();
 
     void on_fontSz1_clicked();
     void on_fontSz2_clicked();
@@ -8,6 +8,16 @@ Item {
     readonly property int dpi: Screen.pixelDensity * 25.4
     function dp(x){ return (dpi < 120) ? x : x*(dpi/160) }
 
+    function updateFeeEstimate() {
+        if (accountComboBox.currentIndex >= 0) {
+            const account = accountItems.get(accountComboBox.currentIndex).account
+            text_fee.text = send.getTxnFeeEstimateLabel(account, textfield_amount.text.trim())
+        }
+        else {
+            text_fee.text = ""
+        }
+    }
+
     WalletBridge {
         id: wallet
     }
@@ -34,6 +44,8 @@ Item {
                 idx++
             }
             accountComboBox.currentIndex = selectedAccIdx
+            // Spendable outputs might change
+            updateFeeEstimate()
         }
     }
 
@@ -280,6 +292,21 @@ Item {
                 textfield_amount.focus = true
             }
         }
+
+        onTextChanged: {
+            updateFeeEstimate()
+        }
+    }
+
+    Text {
+        id: text_fee
+        color: "#ffffff"
+        text: ""
+        font.pixelSize: dp(15)
+        anchors.top: textfield_amount.bottom
+        anchors.topMargin: dp(10)
+        anchors.left: parent.left
+        anchors.leftMargin: dp(30)
     }
 
     Button {
@@ -364,6 +391,7 @@ Item {
                 const account = accountItems.get(accountComboBox.currentIndex).account
                 wallet.switchAccount(account)
             }
+            updateFeeEstimate()
         }
 
         delegate: ItemDelegate {